@@ -0,0 +1,49 @@
+project "Mesh Stats Benchmark"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+    staticruntime "on"
+
+    targetdir (BinDir)
+    objdir (ObjDir)
+
+    files
+    {
+        "src/**.h",
+        "src/**.cpp"
+    }
+
+    includedirs
+    {
+        "src",
+        "%{SourceDirs.Core}",
+        "%{VendorDirs.Core}"
+    }
+
+    links
+    {
+        "Mesh Stats Core"
+    }
+
+    defines
+    {
+        "_SILENCE_CXX17_ITERATOR_BASE_CLASS_DEPRECATION_WARNING"
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+
+    filter "system:linux"
+        links "pthread"
+
+    filter "configurations:Debug"
+        runtime "Debug"
+        defines "DEBUG"
+        optimize "Off"
+        symbols "On"
+
+    filter "configurations:Release"
+        runtime "Release"
+        defines "RELEASE"
+        optimize "On"
+        symbols "Off"
\ No newline at end of file
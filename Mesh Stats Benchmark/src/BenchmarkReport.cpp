@@ -0,0 +1,139 @@
+#include "corepch.h"
+#include "BenchmarkReport.h"
+
+#include "Utils/FileUtils.h"
+#include "Utils/TimeUtils.h"
+
+namespace
+{
+	const char* GetConfiguration()
+	{
+#if defined(DEBUG)
+		return "Debug";
+#elif defined(RELEASE)
+		return "Release";
+#else
+		return "Unknown";
+#endif
+	}
+
+	std::string GetCompiler()
+	{
+#if defined(_MSC_VER)
+		return std::format("MSVC {}", _MSC_VER);
+#elif defined(__clang__)
+		return std::format("Clang {}.{}.{}", __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+		return std::format("GCC {}.{}.{}", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#else
+		return "Unknown";
+#endif
+	}
+
+	// Unmeasured values are printed as "-" and saved as empty CSV fields
+	template<typename T>
+	std::string FormatOptional(const std::optional<T>& value, const double divisor = 1.0)
+	{
+		if (!value) return "-";
+		return divisor == 1.0 ? std::to_string(*value) : std::format("{:.1f}", *value / divisor);
+	}
+}
+
+void BenchmarkReport::Add(BenchmarkReport::Entry&& entry)
+{
+	static constexpr double MEGABYTE = 1024.0 * 1024.0;
+
+	std::cout << std::format("{:<24} {:<36} {:>12} items {:>12.3f} ms {:>16.0f} items/s {:>10} MB RSS {:>10} MB heap {:>10} allocations",
+		entry.MeshName, entry.BenchmarkName, entry.ItemCount, entry.Milliseconds, GetItemsPerSecond(entry),
+		FormatOptional(entry.PeakMemory, MEGABYTE), FormatOptional(entry.PeakHeapMemory, MEGABYTE), FormatOptional(entry.AllocationCount)) << std::endl;
+
+	m_Entries.push_back(std::move(entry));
+}
+
+const std::vector<BenchmarkReport::Entry>& BenchmarkReport::GetEntries() const
+{
+	return m_Entries;
+}
+
+bool BenchmarkReport::Save(const fs::path& filepath) const
+{
+	return filepath.extension() == ".csv"
+		? SaveAsCsv(filepath)
+		: SaveAsJson(filepath);
+}
+
+/*static*/ double BenchmarkReport::GetItemsPerSecond(const BenchmarkReport::Entry& entry)
+{
+	return entry.Milliseconds > 0.0 ? entry.ItemCount / (entry.Milliseconds / 1000.0) : 0.0;
+}
+
+bool BenchmarkReport::SaveAsJson(const fs::path& filepath) const
+{
+	json::StringBuffer jsonStringBuffer;
+	json::Writer<json::StringBuffer> jsonWriter(jsonStringBuffer);
+
+	jsonWriter.StartObject();
+	jsonWriter.Key("date");
+	jsonWriter.String(utils::GetDateTime().c_str());
+	jsonWriter.Key("configuration");
+	jsonWriter.String(GetConfiguration());
+	jsonWriter.Key("compiler");
+	jsonWriter.String(GetCompiler().c_str());
+	jsonWriter.Key("hardware_threads");
+	jsonWriter.Uint(std::thread::hardware_concurrency());
+
+	const auto writeOptional = [&jsonWriter](const std::optional<uint64_t>& value) -> void
+		{
+			if (value)
+				jsonWriter.Uint64(*value);
+			else
+				jsonWriter.Null();
+		};
+
+	jsonWriter.Key("results");
+	jsonWriter.StartArray();
+	for (const auto& entry : m_Entries)
+	{
+		jsonWriter.StartObject();
+		jsonWriter.Key("mesh");
+		jsonWriter.String(entry.MeshName.c_str());
+		jsonWriter.Key("benchmark");
+		jsonWriter.String(entry.BenchmarkName.c_str());
+		jsonWriter.Key("items");
+		jsonWriter.Uint64(entry.ItemCount);
+		jsonWriter.Key("milliseconds");
+		jsonWriter.Double(entry.Milliseconds);
+		jsonWriter.Key("items_per_second");
+		jsonWriter.Double(GetItemsPerSecond(entry));
+		jsonWriter.Key("peak_memory_bytes");
+		writeOptional(entry.PeakMemory);
+		jsonWriter.Key("peak_heap_bytes");
+		writeOptional(entry.PeakHeapMemory);
+		jsonWriter.Key("allocations");
+		writeOptional(entry.AllocationCount);
+		jsonWriter.EndObject();
+	}
+	jsonWriter.EndArray();
+	jsonWriter.EndObject();
+
+	return utils::WriteFile(filepath, jsonStringBuffer.GetString());
+}
+
+bool BenchmarkReport::SaveAsCsv(const fs::path& filepath) const
+{
+	std::string data = "mesh,benchmark,items,milliseconds,items_per_second,peak_memory_bytes,peak_heap_bytes,allocations\n";
+
+	for (const auto& entry : m_Entries)
+	{
+		const auto formatField = [](const std::optional<uint64_t>& value) -> std::string
+			{
+				return value ? std::to_string(*value) : std::string();
+			};
+
+		std::format_to(std::back_inserter(data), "{},{},{},{:.3f},{:.0f},{},{},{}\n",
+			entry.MeshName, entry.BenchmarkName, entry.ItemCount, entry.Milliseconds, GetItemsPerSecond(entry),
+			formatField(entry.PeakMemory), formatField(entry.PeakHeapMemory), formatField(entry.AllocationCount));
+	}
+
+	return utils::WriteFile(filepath, data);
+}
\ No newline at end of file
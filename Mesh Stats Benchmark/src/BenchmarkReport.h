@@ -0,0 +1,36 @@
+#pragma once
+
+// Measurements of the benchmark suite, saved in a format that can be compared between builds
+class BenchmarkReport
+{
+public:
+	struct Entry
+	{
+		std::string MeshName;
+		std::string BenchmarkName;
+		uint64_t ItemCount = 0; // Triangles or queries, the throughput is measured in them
+		double Milliseconds = 0.0;
+		// Empty when not measured, for the stages timed by the profiler within a benchmark, saved as null
+		std::optional<size_t> PeakMemory; // Bytes of peak resident memory, since the start of the benchmark where it can be reset
+		std::optional<size_t> PeakHeapMemory; // Bytes allocated with operator new at the peak, above the usage at the start
+		std::optional<uint64_t> AllocationCount;
+	};
+
+public:
+	// Prints the entry to the standard output
+	void Add(BenchmarkReport::Entry&& entry);
+
+	const std::vector<BenchmarkReport::Entry>& GetEntries() const;
+
+	// The format is chosen by the extension, ".csv" or JSON otherwise
+	bool Save(const fs::path& filepath) const;
+
+	static double GetItemsPerSecond(const BenchmarkReport::Entry& entry);
+
+private:
+	bool SaveAsJson(const fs::path& filepath) const;
+	bool SaveAsCsv(const fs::path& filepath) const;
+
+private:
+	std::vector<BenchmarkReport::Entry> m_Entries;
+};
\ No newline at end of file
@@ -0,0 +1,303 @@
+#include "corepch.h"
+#include "MeshGenerator.h"
+
+#include "Math/Math.h"
+
+namespace
+{
+	constexpr float TORUS_MAJOR_RADIUS = 1.f;
+	constexpr float TORUS_MINOR_RADIUS = 0.5f;
+
+	constexpr uint32_t NOISE_OCTAVE_COUNT = 4;
+	constexpr float NOISE_AMPLITUDE = 0.1f;
+	constexpr float NOISE_JITTER = 0.25f; // Of the grid spacing
+
+	// Vertices of a size x size quad grid, row by row, split into triangles with a consistent winding
+	void AddGridTriangles(std::vector<Triangle32>& triangles, const uint32_t size)
+	{
+		const uint32_t rowLength = size + 1;
+		for (uint32_t y = 0; y < size; ++y)
+		{
+			for (uint32_t x = 0; x < size; ++x)
+			{
+				const uint32_t vertexIndex = y * rowLength + x;
+				triangles.emplace_back(vertexIndex, vertexIndex + 1, vertexIndex + rowLength);
+				triangles.emplace_back(vertexIndex + 1, vertexIndex + rowLength + 1, vertexIndex + rowLength);
+			}
+		}
+	}
+
+	uint32_t GetSideLength(const uint64_t triangleCount, const double trianglesPerSquare)
+	{
+		return std::max(1u, static_cast<uint32_t>(std::lround(std::sqrt(triangleCount / trianglesPerSquare))));
+	}
+}
+
+/*static*/ MeshGenerator::MeshData MeshGenerator::Generate(const MeshGenerator::Shape shape, const uint64_t triangleCount, const uint32_t seed /* = DEFAULT_SEED*/)
+{
+	PROFILE_SCOPE("MeshGenerator::Generate");
+
+	switch (shape)
+	{
+	case Shape::Icosphere: return GenerateIcosphere(GetSideLength(triangleCount, 20.0));
+	case Shape::Grid: return GenerateGrid(GetSideLength(triangleCount, 2.0));
+	case Shape::Torus:
+	{
+		const uint32_t minorSegmentCount = std::max(3u, GetSideLength(triangleCount, 4.0));
+		return GenerateTorus(2 * minorSegmentCount, minorSegmentCount);
+	}
+	case Shape::NoisySurface: return GenerateNoisySurface(GetSideLength(triangleCount, 2.0), seed);
+	}
+
+	ASSERT(false);
+	return {};
+}
+
+/*static*/ void MeshGenerator::Shuffle(MeshGenerator::MeshData& mesh, const uint32_t seed /* = DEFAULT_SEED*/)
+{
+	std::mt19937 randomEngine(seed);
+
+	std::vector<uint32_t> newVertexIndexes(mesh.Vertices.size());
+	std::iota(newVertexIndexes.begin(), newVertexIndexes.end(), 0u);
+	std::shuffle(newVertexIndexes.begin(), newVertexIndexes.end(), randomEngine);
+
+	std::vector<Vector3f> newVertices(mesh.Vertices.size());
+	for (size_t i = 0; i < mesh.Vertices.size(); ++i)
+		newVertices[newVertexIndexes[i]] = mesh.Vertices[i];
+
+	mesh.Vertices = std::move(newVertices);
+
+	for (auto& triangle : mesh.Triangles)
+	{
+		for (auto& vertexIndex : triangle.VertexIndexes)
+			vertexIndex = newVertexIndexes[vertexIndex];
+	}
+
+	std::shuffle(mesh.Triangles.begin(), mesh.Triangles.end(), randomEngine);
+}
+
+/*static*/ std::optional<MeshGenerator::Shape> MeshGenerator::ParseShape(const std::string_view name)
+{
+	for (const auto shape : { Shape::Icosphere, Shape::Grid, Shape::Torus, Shape::NoisySurface })
+	{
+		if (name == GetShapeName(shape))
+			return shape;
+	}
+
+	return std::nullopt;
+}
+
+/*static*/ const char* MeshGenerator::GetShapeName(const MeshGenerator::Shape shape)
+{
+	switch (shape)
+	{
+	case Shape::Icosphere: return "icosphere";
+	case Shape::Grid: return "grid";
+	case Shape::Torus: return "torus";
+	case Shape::NoisySurface: return "noisy";
+	}
+
+	return "unknown";
+}
+
+/*static*/ MeshGenerator::MeshData MeshGenerator::GenerateIcosphere(const uint32_t frequency)
+{
+	// Each face of the icosahedron is split into frequency^2 triangles, the vertices on its edges are shared with the neighbors
+	const float t = (1.f + std::sqrt(5.f)) / 2.f;
+	const std::array<Vector3f, 12> corners =
+	{
+		Vector3f{ -1.f, t, 0.f }, Vector3f{ 1.f, t, 0.f }, Vector3f{ -1.f, -t, 0.f }, Vector3f{ 1.f, -t, 0.f },
+		Vector3f{ 0.f, -1.f, t }, Vector3f{ 0.f, 1.f, t }, Vector3f{ 0.f, -1.f, -t }, Vector3f{ 0.f, 1.f, -t },
+		Vector3f{ t, 0.f, -1.f }, Vector3f{ t, 0.f, 1.f }, Vector3f{ -t, 0.f, -1.f }, Vector3f{ -t, 0.f, 1.f }
+	};
+
+	const std::array<std::array<uint32_t, 3>, 20> faces =
+	{ {
+		{ 0, 11, 5 }, { 0, 5, 1 }, { 0, 1, 7 }, { 0, 7, 10 }, { 0, 10, 11 },
+		{ 1, 5, 9 }, { 5, 11, 4 }, { 11, 10, 2 }, { 10, 7, 6 }, { 7, 1, 8 },
+		{ 3, 9, 4 }, { 3, 4, 2 }, { 3, 2, 6 }, { 3, 6, 8 }, { 3, 8, 9 },
+		{ 4, 9, 5 }, { 2, 4, 11 }, { 6, 2, 10 }, { 8, 6, 7 }, { 9, 8, 1 }
+	} };
+
+	const uint32_t n = frequency;
+	const uint32_t edgeVertexCount = n - 1;
+	const uint32_t faceVertexCount = n > 2 ? (n - 1) * (n - 2) / 2 : 0;
+
+	MeshData mesh;
+	mesh.Vertices.reserve(12 + 30 * size_t(edgeVertexCount) + 20 * size_t(faceVertexCount));
+	mesh.Triangles.reserve(20 * size_t(n) * n);
+
+	for (const auto& corner : corners)
+		mesh.Vertices.push_back(corner.Normalized());
+
+	// The first vertex of the edge between corners u < v, the others follow from u to v
+	std::array<std::array<uint32_t, 12>, 12> edgeFirstVertexIndexes;
+	for (auto& row : edgeFirstVertexIndexes)
+		row.fill(std::numeric_limits<uint32_t>::max());
+
+	for (const auto& face : faces)
+	{
+		for (uint32_t i = 0; i < 3; ++i)
+		{
+			const uint32_t u = std::min(face[i], face[(i + 1) % 3]);
+			const uint32_t v = std::max(face[i], face[(i + 1) % 3]);
+			if (edgeFirstVertexIndexes[u][v] != std::numeric_limits<uint32_t>::max())
+				continue;
+
+			edgeFirstVertexIndexes[u][v] = static_cast<uint32_t>(mesh.Vertices.size());
+			for (uint32_t k = 1; k < n; ++k)
+				mesh.Vertices.push_back((corners[u] + (corners[v] - corners[u]) * (float(k) / n)).Normalized());
+		}
+	}
+
+	// Index of the k-th of the n steps from corner u to corner v
+	const auto getEdgeVertexIndex = [&](const uint32_t u, const uint32_t v, const uint32_t k) -> uint32_t
+		{
+			if (k == 0) return u;
+			if (k == n) return v;
+
+			const uint32_t firstVertexIndex = edgeFirstVertexIndexes[std::min(u, v)][std::max(u, v)];
+			return u < v ? firstVertexIndex + k - 1 : firstVertexIndex + n - k - 1;
+		};
+
+	std::vector<uint32_t> faceVertexIndexes;
+	for (const auto& face : faces)
+	{
+		const uint32_t a = face[0];
+		const uint32_t b = face[1];
+		const uint32_t c = face[2];
+
+		// Vertex (i, j) lies at a + (b - a) * i / n + (c - a) * j / n, stored row by row
+		const auto getRowStart = [n](const uint32_t i) -> uint32_t { return i * (n + 1) - i * (i - 1) / 2; };
+
+		faceVertexIndexes.resize(getRowStart(n + 1));
+		for (uint32_t i = 0; i <= n; ++i)
+		{
+			for (uint32_t j = 0; i + j <= n; ++j)
+			{
+				uint32_t vertexIndex;
+				if (j == 0) vertexIndex = getEdgeVertexIndex(a, b, i);
+				else if (i == 0) vertexIndex = getEdgeVertexIndex(a, c, j);
+				else if (i + j == n) vertexIndex = getEdgeVertexIndex(b, c, j);
+				else
+				{
+					vertexIndex = static_cast<uint32_t>(mesh.Vertices.size());
+					const auto point = corners[a] + (corners[b] - corners[a]) * (float(i) / n) + (corners[c] - corners[a]) * (float(j) / n);
+					mesh.Vertices.push_back(point.Normalized());
+				}
+
+				faceVertexIndexes[getRowStart(i) + j] = vertexIndex;
+			}
+		}
+
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			for (uint32_t j = 0; i + j < n; ++j)
+			{
+				const uint32_t vertexIndex = faceVertexIndexes[getRowStart(i) + j];
+				const uint32_t nextIVertexIndex = faceVertexIndexes[getRowStart(i + 1) + j];
+				const uint32_t nextJVertexIndex = faceVertexIndexes[getRowStart(i) + j + 1];
+				mesh.Triangles.emplace_back(vertexIndex, nextIVertexIndex, nextJVertexIndex);
+
+				if (i + j + 1 < n)
+					mesh.Triangles.emplace_back(nextIVertexIndex, faceVertexIndexes[getRowStart(i + 1) + j + 1], nextJVertexIndex);
+			}
+		}
+	}
+
+	return mesh;
+}
+
+/*static*/ MeshGenerator::MeshData MeshGenerator::GenerateGrid(const uint32_t size)
+{
+	MeshData mesh;
+	mesh.Vertices.reserve(size_t(size + 1) * (size + 1));
+	mesh.Triangles.reserve(2 * size_t(size) * size);
+
+	for (uint32_t y = 0; y <= size; ++y)
+	{
+		for (uint32_t x = 0; x <= size; ++x)
+			mesh.Vertices.emplace_back(float(x) / size, float(y) / size, 0.f);
+	}
+
+	AddGridTriangles(mesh.Triangles, size);
+	return mesh;
+}
+
+/*static*/ MeshGenerator::MeshData MeshGenerator::GenerateTorus(const uint32_t majorSegmentCount, const uint32_t minorSegmentCount)
+{
+	MeshData mesh;
+	mesh.Vertices.reserve(size_t(majorSegmentCount) * minorSegmentCount);
+	mesh.Triangles.reserve(2 * size_t(majorSegmentCount) * minorSegmentCount);
+
+	for (uint32_t i = 0; i < majorSegmentCount; ++i)
+	{
+		const float majorAngle = 2.f * PI * i / majorSegmentCount;
+		for (uint32_t j = 0; j < minorSegmentCount; ++j)
+		{
+			const float minorAngle = 2.f * PI * j / minorSegmentCount;
+			const float radius = TORUS_MAJOR_RADIUS + TORUS_MINOR_RADIUS * std::cos(minorAngle);
+			mesh.Vertices.emplace_back(radius * std::cos(majorAngle), radius * std::sin(majorAngle), TORUS_MINOR_RADIUS * std::sin(minorAngle));
+		}
+	}
+
+	// Both directions wrap around, so the surface is closed
+	for (uint32_t i = 0; i < majorSegmentCount; ++i)
+	{
+		const uint32_t nextI = (i + 1) % majorSegmentCount;
+		for (uint32_t j = 0; j < minorSegmentCount; ++j)
+		{
+			const uint32_t nextJ = (j + 1) % minorSegmentCount;
+			const uint32_t vertexIndex00 = i * minorSegmentCount + j;
+			const uint32_t vertexIndex10 = nextI * minorSegmentCount + j;
+			const uint32_t vertexIndex01 = i * minorSegmentCount + nextJ;
+			const uint32_t vertexIndex11 = nextI * minorSegmentCount + nextJ;
+
+			mesh.Triangles.emplace_back(vertexIndex00, vertexIndex10, vertexIndex01);
+			mesh.Triangles.emplace_back(vertexIndex10, vertexIndex11, vertexIndex01);
+		}
+	}
+
+	return mesh;
+}
+
+/*static*/ MeshGenerator::MeshData MeshGenerator::GenerateNoisySurface(const uint32_t size, const uint32_t seed)
+{
+	std::mt19937 randomEngine(seed);
+	std::uniform_real_distribution<float> phaseDistribution(0.f, 2.f * PI);
+	std::uniform_real_distribution<float> jitterDistribution(-NOISE_JITTER, NOISE_JITTER);
+
+	// Sum of sine waves with random phases, halving the amplitude of each octave
+	std::array<std::array<float, 2>, NOISE_OCTAVE_COUNT> phases;
+	for (auto& phase : phases)
+		phase = { phaseDistribution(randomEngine), phaseDistribution(randomEngine) };
+
+	MeshData mesh;
+	mesh.Vertices.reserve(size_t(size + 1) * (size + 1));
+	mesh.Triangles.reserve(2 * size_t(size) * size);
+
+	const float spacing = 1.f / size;
+	for (uint32_t y = 0; y <= size; ++y)
+	{
+		for (uint32_t x = 0; x <= size; ++x)
+		{
+			const float u = x * spacing + jitterDistribution(randomEngine) * spacing;
+			const float v = y * spacing + jitterDistribution(randomEngine) * spacing;
+
+			float height = 0.f;
+			float amplitude = NOISE_AMPLITUDE;
+			float frequency = 2.f * PI;
+			for (const auto& phase : phases)
+			{
+				height += amplitude * std::sin(frequency * u + phase[0]) * std::cos(frequency * v + phase[1]);
+				amplitude *= 0.5f;
+				frequency *= 2.f;
+			}
+
+			mesh.Vertices.emplace_back(u, v, height + jitterDistribution(randomEngine) * spacing);
+		}
+	}
+
+	AddGridTriangles(mesh.Triangles, size);
+	return mesh;
+}
\ No newline at end of file
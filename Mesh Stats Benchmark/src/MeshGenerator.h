@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Core/Triangle.h"
+#include "Math/Vector3.h"
+
+// Procedural meshes of a requested size, for benchmarks
+class MeshGenerator
+{
+public:
+	enum class Shape : uint8_t
+	{
+		Icosphere, // Closed, subdivided icosahedron projected on the unit sphere
+		Grid, // Open, flat square
+		Torus, // Closed, major radius twice the minor one
+		NoisySurface // Open, randomly displaced height field
+	};
+
+	// Kept apart from Mesh, so generation and initialization can be measured separately
+	struct MeshData
+	{
+		std::vector<Vector3f> Vertices;
+		std::vector<Triangle32> Triangles;
+	};
+
+	static constexpr uint32_t DEFAULT_SEED = 42;
+
+public:
+	// The triangle count is rounded to the nearest one the shape can be tessellated to
+	static MeshGenerator::MeshData Generate(const MeshGenerator::Shape shape, const uint64_t triangleCount, const uint32_t seed = DEFAULT_SEED);
+
+	// Randomly permutes the vertices and triangles, like the arbitrary order of scanned or exported meshes
+	static void Shuffle(MeshGenerator::MeshData& mesh, const uint32_t seed = DEFAULT_SEED);
+
+	static std::optional<MeshGenerator::Shape> ParseShape(const std::string_view name);
+	static const char* GetShapeName(const MeshGenerator::Shape shape);
+
+private:
+	static MeshGenerator::MeshData GenerateIcosphere(const uint32_t frequency);
+	static MeshGenerator::MeshData GenerateGrid(const uint32_t size);
+	static MeshGenerator::MeshData GenerateTorus(const uint32_t majorSegmentCount, const uint32_t minorSegmentCount);
+	static MeshGenerator::MeshData GenerateNoisySurface(const uint32_t size, const uint32_t seed);
+};
\ No newline at end of file
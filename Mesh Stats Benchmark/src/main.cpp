@@ -0,0 +1,424 @@
+#include "corepch.h"
+
+#include "BenchmarkReport.h"
+#include "MeshGenerator.h"
+
+#include "Core/Mesh.h"
+#include "Core/MeshReorder.h"
+#include "Math/AABB.h"
+#include "Utils/AllocationHooks.h"
+#include "Utils/MemoryUtils.h"
+#include "Utils/Profiler.h"
+#include "Utils/TimeUtils.h"
+
+namespace
+{
+	constexpr uint32_t DEFAULT_SUBDIVISION_COUNT = 0;
+	constexpr uint32_t DEFAULT_QUERY_COUNT = 100000;
+	constexpr uint32_t MAX_BRUTE_FORCE_QUERY_COUNT = 1000;
+	constexpr uint32_t RANDOM_SEED = 42;
+
+	// Keeps the subdivided meshes well within the 32-bit triangle indexes of the spatial queries
+	constexpr uint64_t MAX_SUBDIVISION_TRIANGLE_COUNT = 1 << 28;
+
+	// Generated when neither meshes nor shapes are given
+	constexpr std::array<uint64_t, 2> DEFAULT_TRIANGLE_COUNTS = { 100000, 1000000 };
+
+	// Initialization stages, read back from the profiler
+	constexpr std::array<std::pair<const char*, const char*>, 3> INIT_STAGES =
+	{ {
+		{ "Mesh::CalculateSmoothVertexNormals", "init_smooth_vertex_normals" },
+		{ "Mesh::CalculateStatistics", "init_statistics" },
+		{ "Mesh::CalculateEdgeCountAndIsClosed", "init_edge_count_and_is_closed" }
+	} };
+
+	struct Options
+	{
+		std::vector<fs::path> MeshPaths;
+		std::vector<std::pair<MeshGenerator::Shape, uint64_t>> GeneratedMeshes; // Shape and approximate triangle count
+		uint32_t SubdivisionCount = DEFAULT_SUBDIVISION_COUNT;
+		uint32_t QueryCount = DEFAULT_QUERY_COUNT;
+		bool SkipFileBenchmarks = false;
+		bool Shuffle = false; // Of the generated meshes
+		bool Reorder = false; // Also benchmarks a copy of every mesh reordered for locality
+		PositionBuffer::Encoding VertexEncoding = PositionBuffer::Encoding::Float; // Of every mesh
+		fs::path OutputPath;
+	};
+
+	void PrintUsage()
+	{
+		std::cout << "Usage: \"Mesh Stats Benchmark\" [meshes.json...] [--generate <icosphere|grid|torus|noisy> <triangles>]...\n"
+			<< "    [--subdivisions <count>] [--queries <count>] [--skip-files] [--shuffle] [--reorder]\n"
+			<< "    [--compact <16|21>] [--output <results.json|results.csv>]\n"
+			<< "  Without meshes, every shape is generated with 10^5 and 10^6 triangles\n"
+			<< "  --shuffle randomizes the vertex and triangle order of the generated meshes, --reorder compares each mesh with a copy reordered for locality\n"
+			<< "  --compact stores the vertices quantized to 16 or 21 bits per axis and the normals octahedral-encoded"
+			<< std::endl;
+	}
+
+	template<typename T>
+	bool ParseNumber(const std::string_view text, T& value)
+	{
+		const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return error == std::errc() && end == text.data() + text.size();
+	}
+
+	// Also accepts scientific notation, like 1e8
+	bool ParseCount(const std::string_view text, uint64_t& count)
+	{
+		double value = 0.0;
+		if (!ParseNumber(text, value) || value < 1.0 || value > double(std::numeric_limits<uint32_t>::max()))
+			return false;
+
+		count = static_cast<uint64_t>(value);
+		return true;
+	}
+
+	std::optional<Options> ParseOptions(const std::vector<std::string_view>& args)
+	{
+		Options options;
+		for (size_t i = 0; i < args.size(); ++i)
+		{
+			const bool hasValue = i + 1 < args.size();
+
+			bool isValid = true;
+			if (!args[i].starts_with("--"))
+			{
+				options.MeshPaths.emplace_back(args[i]);
+			}
+			else if (args[i] == "--generate" && i + 2 < args.size())
+			{
+				const auto shape = MeshGenerator::ParseShape(args[++i]);
+				uint64_t triangleCount = 0;
+				isValid = shape && ParseCount(args[++i], triangleCount);
+				if (isValid)
+					options.GeneratedMeshes.emplace_back(*shape, triangleCount);
+			}
+			else if (args[i] == "--subdivisions" && hasValue)
+			{
+				isValid = ParseNumber(args[++i], options.SubdivisionCount);
+			}
+			else if (args[i] == "--queries" && hasValue)
+			{
+				isValid = ParseNumber(args[++i], options.QueryCount);
+			}
+			else if (args[i] == "--skip-files")
+			{
+				options.SkipFileBenchmarks = true;
+			}
+			else if (args[i] == "--shuffle")
+			{
+				options.Shuffle = true;
+			}
+			else if (args[i] == "--reorder")
+			{
+				options.Reorder = true;
+			}
+			else if (args[i] == "--compact" && hasValue)
+			{
+				const auto bits = args[++i];
+				isValid = bits == "16" || bits == "21";
+				options.VertexEncoding = bits == "16" ? PositionBuffer::Encoding::Quantized16 : PositionBuffer::Encoding::Quantized21;
+			}
+			else if (args[i] == "--output" && hasValue)
+			{
+				options.OutputPath = args[++i];
+			}
+			else
+			{
+				isValid = false;
+			}
+
+			if (!isValid)
+				return std::nullopt;
+		}
+
+		if (options.MeshPaths.empty() && options.GeneratedMeshes.empty())
+		{
+			for (const auto triangleCount : DEFAULT_TRIANGLE_COUNTS)
+			{
+				for (const auto shape : { MeshGenerator::Shape::Icosphere, MeshGenerator::Shape::Grid, MeshGenerator::Shape::Torus, MeshGenerator::Shape::NoisySurface })
+					options.GeneratedMeshes.emplace_back(shape, triangleCount);
+			}
+		}
+
+		return options;
+	}
+
+	// Times the function and adds it to the report, along with the peak memory it reached
+	// The function may return the item count, if it is only known afterwards
+	template<typename Function>
+	void Measure(BenchmarkReport& report, const std::string& meshName, const std::string& benchmarkName, uint64_t itemCount, Function&& function)
+	{
+		utils::ResetPeakResidentMemory();
+		utils::AllocationScope allocationScope;
+
+		const utils::Timer timer;
+		if constexpr (std::is_void_v<std::invoke_result_t<Function>>)
+			function();
+		else
+			itemCount = function();
+
+		const double milliseconds = timer.GetElapsedMilliseconds();
+		const auto allocations = allocationScope.Stop();
+
+		report.Add({ meshName, benchmarkName, itemCount, milliseconds, utils::GetPeakResidentMemory(), allocations.PeakBytes, allocations.AllocationCount });
+	}
+
+	std::vector<Vector3f> GenerateQueryPoints(const Mesh& mesh, const uint32_t count)
+	{
+		AABBf bounds;
+		const auto& vertices = mesh.GetVertices();
+		for (size_t i = 0; i < vertices.GetCount(); ++i)
+			bounds.Extend(vertices.Get(i));
+
+		std::mt19937 randomEngine(RANDOM_SEED);
+		std::uniform_real_distribution<float> distributionX(bounds.Min.x, bounds.Max.x);
+		std::uniform_real_distribution<float> distributionY(bounds.Min.y, bounds.Max.y);
+		std::uniform_real_distribution<float> distributionZ(bounds.Min.z, bounds.Max.z);
+
+		std::vector<Vector3f> points;
+		points.reserve(count);
+		for (uint32_t i = 0; i < count; ++i)
+			points.emplace_back(distributionX(randomEngine), distributionY(randomEngine), distributionZ(randomEngine));
+
+		return points;
+	}
+
+	// Measures the function, which initializes a mesh, and adds the time of each initialization stage to the report
+	template<typename Function>
+	void MeasureInit(BenchmarkReport& report, const std::string& meshName, const std::string& benchmarkName, const uint64_t itemCount, Function&& function)
+	{
+		auto& profiler = utils::Profiler::Get();
+		const bool wasProfilerEnabled = profiler.IsEnabled();
+		profiler.Clear();
+		profiler.SetEnabled(true);
+
+		Measure(report, meshName, benchmarkName, itemCount, std::forward<Function>(function));
+
+		profiler.SetEnabled(wasProfilerEnabled);
+
+		// The stages are only recorded if profiling was compiled in, and only timed: they run concurrently, so their memory
+		// is left unmeasured rather than attributed the one of the whole initialization
+		const auto initEntry = report.GetEntries().back();
+		const auto events = profiler.GetEvents();
+		for (const auto& [scopeName, stageBenchmarkName] : INIT_STAGES)
+		{
+			const auto event = std::find_if(events.begin(), events.end(),
+				[scopeName](const utils::Profiler::Event& event) -> bool { return std::strcmp(event.Name, scopeName) == 0; });
+
+			if (event != events.end())
+				report.Add({ meshName, stageBenchmarkName, initEntry.ItemCount, event->Duration / 1000.0 });
+		}
+
+		profiler.Clear();
+	}
+
+	// The vertices are encoded before the measurement
+	Mesh CreateMesh(BenchmarkReport& report, const std::string& meshName, PositionBuffer&& vertices, TriangleBuffer&& triangles)
+	{
+		std::optional<Mesh> mesh;
+		MeasureInit(report, meshName, "init", triangles.GetCount(),
+			[&]() -> void
+			{
+				// The analyses are lazy, they are started together and waited for like a client reading all of them
+				mesh.emplace(std::move(vertices), std::move(triangles));
+				mesh->Prefetch();
+				for (const auto analysis : Mesh::ANALYSES)
+					mesh->GetFuture(analysis).wait();
+			}
+		);
+
+		return std::move(*mesh);
+	}
+
+	void PrintMesh(const std::string& meshName, const Mesh& mesh)
+	{
+		const auto& vertices = mesh.GetVertices();
+		std::cout << std::format("{}: {} vertices ({}), {} triangles, {} edges, {}, {:.2f} vertex cache misses per triangle",
+			meshName, vertices.GetCount(), PositionBuffer::GetEncodingName(vertices.GetEncoding()), mesh.GetTriangles().GetCount(),
+			mesh.GetEdgeCount(), mesh.IsClosed() ? "closed" : "open", MeshReorder::GetAverageCacheMissRatio(mesh.GetTriangles(), vertices.GetCount())) << std::endl;
+
+		if (vertices.IsQuantized())
+		{
+			std::cout << std::format("{}: vertex error up to {:.3g}, normal error up to {:.3g} degrees, {} held by the mesh",
+				meshName, vertices.GetMaxError(), RadToDeg(mesh.GetSmoothVertexNormals().GetMaxAngularError()),
+				utils::FormatBytes(mesh.GetMemoryUsage().GetTotal())) << std::endl;
+		}
+	}
+
+	// Returns the number of query results that disagree between the different inside tests
+	uint32_t RunMeshBenchmarks(BenchmarkReport& report, const std::string& meshName, const Mesh& mesh, const Options& options)
+	{
+		const uint64_t triangleCount = mesh.GetTriangles().GetCount();
+		PrintMesh(meshName, mesh);
+
+		Measure(report, meshName, "bvh_build", triangleCount, [&]() -> void { mesh.GetBVH(); });
+
+		if (!options.SkipFileBenchmarks)
+		{
+			const auto filepath = fs::temp_directory_path() / std::format("{}.benchmark.json", meshName);
+			Measure(report, meshName, "save_json", triangleCount, [&]() -> void { Mesh::SaveToFile(filepath, mesh); });
+			Measure(report, meshName, "load_json", triangleCount, [&]() -> void { Mesh::LoadFromFile(filepath); });
+
+			std::error_code errorCode;
+			fs::remove(filepath, errorCode);
+		}
+
+		if (triangleCount * 4 <= MAX_SUBDIVISION_TRIANGLE_COUNT)
+		{
+			Measure(report, meshName, "subdivide", triangleCount, [&]() -> void { mesh.GenerateSubdividedMesh(); });
+
+			// Like a batch subdivision: the analyses of the result run as tasks, on threads started for them, whose
+			// scratch arenas reuse the blocks the previous operations gave back to the pool
+			Measure(report, meshName, "subdivide_and_analyze", triangleCount,
+				[&]() -> void
+				{
+					const Mesh subdividedMesh = mesh.GenerateSubdividedMesh();
+					subdividedMesh.Prefetch();
+					for (const auto analysis : Mesh::ANALYSES)
+						subdividedMesh.GetFuture(analysis).wait();
+				}
+			);
+		}
+
+		const uint32_t queryCount = options.QueryCount;
+		const uint32_t bruteForceQueryCount = std::min(queryCount, MAX_BRUTE_FORCE_QUERY_COUNT);
+		const auto points = GenerateQueryPoints(mesh, queryCount);
+
+		std::vector<bool> singleResults(queryCount);
+		Measure(report, meshName, "inside_single_thread", queryCount,
+			[&]() -> void
+			{
+				for (uint32_t i = 0; i < queryCount; ++i)
+					singleResults[i] = mesh.IsPointInsideMesh(points[i]);
+			}
+		);
+
+		std::vector<bool> bruteForceResults(bruteForceQueryCount);
+		Measure(report, meshName, "inside_brute_force", bruteForceQueryCount,
+			[&]() -> void
+			{
+				for (uint32_t i = 0; i < bruteForceQueryCount; ++i)
+					bruteForceResults[i] = mesh.IsPointInsideMeshBruteForce(points[i]);
+			}
+		);
+
+		utils::BitSet batchResults;
+		Measure(report, meshName, "inside_batch", queryCount, [&]() -> void { batchResults = mesh.ArePointsInsideMesh(points); });
+
+		std::vector<float> signedDistances;
+		Measure(report, meshName, "signed_distance_batch", queryCount, [&]() -> void { signedDistances = mesh.SignedDistances(points); });
+
+		Mesh::InsideTestOptions windingNumberOptions;
+		windingNumberOptions.Mode = Mesh::InsideTestMode::WindingNumber;
+		Measure(report, meshName, "winding_number_batch", queryCount, [&]() -> void { mesh.ArePointsInsideMesh(points, windingNumberOptions); });
+
+		uint32_t mismatchCount = 0;
+		for (uint32_t i = 0; i < queryCount; ++i)
+		{
+			if (singleResults[i] != batchResults[i] || singleResults[i] != (signedDistances[i] < 0.f) || (i < bruteForceQueryCount && singleResults[i] != bruteForceResults[i]))
+				++mismatchCount;
+		}
+
+		if (mismatchCount > 0)
+			std::cerr << std::format("{}: {} mismatches between the inside tests", meshName, mismatchCount) << std::endl;
+
+		return mismatchCount;
+	}
+
+	// Benchmarks the mesh, and a copy reordered for locality if requested, which both go through the same passes
+	uint32_t RunAllBenchmarks(BenchmarkReport& report, const std::string& meshName, Mesh&& mesh, const Options& options)
+	{
+		for (uint32_t i = 0; i < options.SubdivisionCount; ++i)
+			mesh = mesh.GenerateSubdividedMesh();
+
+		uint32_t mismatchCount = RunMeshBenchmarks(report, meshName, mesh, options);
+		if (!options.Reorder) return mismatchCount;
+
+		const auto reorderedMeshName = meshName + "_reordered";
+		const uint64_t triangleCount = mesh.GetTriangles().GetCount();
+
+		const auto vertexEncoding = mesh.GetVertices().GetEncoding();
+		auto vertices = mesh.GetVertices().Decode();
+		auto triangles = mesh.GetTriangles();
+		{
+			const Mesh original = std::move(mesh); // Freed before the reordered copy is initialized
+		}
+
+		Measure(report, reorderedMeshName, "reorder", triangleCount, [&]() -> void { MeshReorder::Reorder(vertices, triangles); });
+		const auto reorderedMesh = CreateMesh(report, reorderedMeshName, PositionBuffer(std::move(vertices), vertexEncoding), std::move(triangles));
+
+		mismatchCount += RunMeshBenchmarks(report, reorderedMeshName, reorderedMesh, options);
+		return mismatchCount;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const auto options = ParseOptions(std::vector<std::string_view>(argv + 1, argv + argc));
+	if (!options)
+	{
+		PrintUsage();
+		return EXIT_FAILURE;
+	}
+
+	BenchmarkReport report;
+	uint32_t mismatchCount = 0;
+	bool hasFailed = false;
+
+	for (const auto& meshPath : options->MeshPaths)
+	{
+		const auto meshName = meshPath.stem().string();
+
+		std::optional<Mesh> mesh;
+		Measure(report, meshName, "load_file", 0,
+			[&]() -> uint64_t
+			{
+				Mesh::LoadOptions loadOptions;
+				loadOptions.VertexEncoding = options->VertexEncoding;
+				mesh = Mesh::LoadFromFile(meshPath, loadOptions);
+				return mesh ? mesh->GetTriangles().GetCount() : 0;
+			}
+		);
+
+		if (!mesh)
+		{
+			std::cerr << std::format("Could not load mesh from: \"{}\"", meshPath.string()) << std::endl;
+			hasFailed = true;
+			continue;
+		}
+
+		mismatchCount += RunAllBenchmarks(report, meshName, std::move(*mesh), *options);
+	}
+
+	for (const auto& [shape, requestedTriangleCount] : options->GeneratedMeshes)
+	{
+		const auto meshName = std::format("{}_{}", MeshGenerator::GetShapeName(shape), requestedTriangleCount);
+
+		MeshGenerator::MeshData meshData;
+		Measure(report, meshName, "generate", 0,
+			[&]() -> uint64_t
+			{
+				meshData = MeshGenerator::Generate(shape, requestedTriangleCount);
+				return meshData.Triangles.size();
+			}
+		);
+
+		if (options->Shuffle)
+			MeshGenerator::Shuffle(meshData);
+
+		const size_t vertexCount = meshData.Vertices.size();
+		auto mesh = CreateMesh(report, meshName, PositionBuffer(std::move(meshData.Vertices), options->VertexEncoding),
+			TriangleBuffer(std::move(meshData.Triangles), vertexCount));
+		mismatchCount += RunAllBenchmarks(report, meshName, std::move(mesh), *options);
+	}
+
+	if (!options->OutputPath.empty() && !report.Save(options->OutputPath))
+	{
+		std::cerr << std::format("Could not save results to: \"{}\"", options->OutputPath.string()) << std::endl;
+		hasFailed = true;
+	}
+
+	return mismatchCount == 0 && !hasFailed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include "corepch.h"
+#include "BatchProcessor.h"
+
+#include "Core/PointsFile.h"
+#include "Utils/FileUtils.h"
+#include "Utils/MemoryUtils.h"
+#include "Utils/ScratchArena.h"
+#include "Utils/ThreadUtils.h"
+#include "Utils/TimeUtils.h"
+
+namespace
+{
+	constexpr const char* MESH_FILE_EXTENSION = ".json";
+
+	std::string EscapeCsv(const std::string& text)
+	{
+		if (text.find_first_of(",\"\n") == std::string::npos)
+			return text;
+
+		std::string escapedText = "\"";
+		for (const char character : text)
+		{
+			if (character == '"')
+				escapedText += '"';
+			escapedText += character;
+		}
+
+		return escapedText += '"';
+	}
+}
+
+/*static*/ std::optional<BatchProcessor> BatchProcessor::Create(const BatchProcessor::Options& options)
+{
+	std::vector<fs::path> filepaths;
+	std::vector<fs::path> relativeFilepaths; // To the directory searched, or only the filename for files and wildcards
+	for (const auto& filePattern : options.FilePatterns)
+	{
+		auto matchingFilepaths = utils::FindFiles(filePattern, MESH_FILE_EXTENSION);
+		if (matchingFilepaths.empty())
+			std::cerr << std::format("No files match: \"{}\"", filePattern) << std::endl;
+
+		std::error_code error;
+		const bool isDirectory = fs::is_directory(filePattern, error);
+		for (auto& filepath : matchingFilepaths)
+		{
+			relativeFilepaths.push_back(isDirectory ? filepath.lexically_relative(filePattern) : filepath.filename());
+			filepaths.push_back(std::move(filepath));
+		}
+	}
+
+	if (filepaths.empty())
+	{
+		std::cerr << "No mesh files to process" << std::endl;
+		return {};
+	}
+
+	std::vector<Vector3f> points;
+	if (!options.PointsPath.empty())
+	{
+		auto loadedPoints = PointsFile::LoadPoints(options.PointsPath);
+		if (!loadedPoints)
+		{
+			std::cerr << std::format("File does not exist or has incorrect format: \"{}\"", options.PointsPath.string()) << std::endl;
+			return {};
+		}
+
+		points = std::move(*loadedPoints);
+	}
+
+	std::vector<fs::path> convertedFilepaths;
+	if (!options.ConvertDirectory.empty())
+	{
+		// The input directories are mirrored, the names that still collide (same file twice, or the same name under
+		// different patterns) get a suffix, so no two files are written to the same path concurrently
+		const auto convertedExtension = options.ConvertFormat == ConvertFormat::Obj ? ".obj" : MESH_FILE_EXTENSION;
+		std::unordered_set<std::string> usedFilepaths;
+		convertedFilepaths.reserve(filepaths.size());
+		for (size_t i = 0; i < filepaths.size(); ++i)
+		{
+			auto convertedFilepath = options.ConvertDirectory / relativeFilepaths[i];
+			convertedFilepath.replace_extension(convertedExtension);
+
+			const auto stem = convertedFilepath.stem().string();
+			for (uint32_t suffix = 2; usedFilepaths.contains(convertedFilepath.string()); ++suffix)
+				convertedFilepath.replace_filename(std::format("{}_{}{}", stem, suffix, convertedExtension));
+
+			if (convertedFilepath.stem() != stem)
+			{
+				std::cerr << std::format("Converted files collide, \"{}\" is saved to: \"{}\"",
+					filepaths[i].string(), convertedFilepath.string()) << std::endl;
+			}
+
+			// Created before the files are processed concurrently
+			std::error_code error;
+			fs::create_directories(convertedFilepath.parent_path(), error);
+			if (error)
+			{
+				std::cerr << std::format("Could not create directory: \"{}\"", convertedFilepath.parent_path().string()) << std::endl;
+				return {};
+			}
+
+			usedFilepaths.insert(convertedFilepath.string());
+			convertedFilepaths.push_back(std::move(convertedFilepath));
+		}
+	}
+
+	return BatchProcessor(options, std::move(filepaths), std::move(convertedFilepaths), std::move(points));
+}
+
+BatchProcessor::BatchProcessor(const BatchProcessor::Options& options, std::vector<fs::path>&& filepaths,
+	std::vector<fs::path>&& convertedFilepaths, std::vector<Vector3f>&& points)
+	: m_Options(options)
+	, m_Filepaths(std::move(filepaths))
+	, m_ConvertedFilepaths(std::move(convertedFilepaths))
+	, m_Points(std::move(points))
+{
+}
+
+void BatchProcessor::Run()
+{
+	PROFILE_SCOPE("BatchProcessor::Run");
+
+	m_Results.assign(m_Filepaths.size(), {});
+
+	// Files are handed out one at a time, so a few big meshes do not leave the other threads idle
+	const uint32_t threadCount = m_Options.ThreadCount > 0 ? m_Options.ThreadCount : utils::GetThreadCount();
+	utils::ParallelForEach(m_Filepaths.size(), threadCount,
+		[this](const size_t index) -> void
+		{
+			// A file that throws (out of memory for instance) fails alone instead of ending the batch
+			try
+			{
+				m_Results[index] = ProcessFile(index);
+			}
+			catch (const std::exception& exception)
+			{
+				m_Results[index] = {};
+				m_Results[index].Filepath = m_Filepaths[index];
+				m_Results[index].Error = std::format("Unexpected error: {}", exception.what());
+			}
+		}
+	);
+
+	utils::ScratchArena::ReleaseRetained();
+}
+
+const std::vector<fs::path>& BatchProcessor::GetFilepaths() const
+{
+	return m_Filepaths;
+}
+
+const std::vector<BatchProcessor::Result>& BatchProcessor::GetResults() const
+{
+	return m_Results;
+}
+
+size_t BatchProcessor::GetFailedCount() const
+{
+	return std::count_if(m_Results.begin(), m_Results.end(),
+		[](const Result& result) -> bool
+		{
+			return !result.Error.empty();
+		}
+	);
+}
+
+bool BatchProcessor::SaveResults(const fs::path& filepath) const
+{
+	return filepath.extension() == ".csv"
+		? SaveResultsAsCsv(filepath)
+		: SaveResultsAsJson(filepath);
+}
+
+BatchProcessor::Result BatchProcessor::ProcessFile(const size_t index) const
+{
+	PROFILE_SCOPE("BatchProcessor::ProcessFile");
+
+	const auto& filepath = m_Filepaths[index];
+
+	const utils::Timer timer;
+	utils::AllocationScope allocationScope;
+
+	Result result;
+	result.Filepath = filepath;
+
+	auto mesh = Mesh::LoadFromFile(filepath, m_Options.LoadOptions);
+	if (!mesh)
+	{
+		result.Error = "File does not exist or has incorrect format";
+		result.Milliseconds = timer.GetElapsedMilliseconds();
+		return result;
+	}
+
+	for (uint32_t i = 0; i < m_Options.SubdivisionCount; ++i)
+		mesh = mesh->GenerateSubdividedMesh();
+
+	// Only the edges of the coarser levels were needed, the analyses of the last one and the structure of the inside test
+	// are computed concurrently
+	mesh->Prefetch();
+	if (!m_Points.empty())
+	{
+		const auto insideTestStructure = m_Options.InsideTestOptions.Mode == Mesh::InsideTestMode::WindingNumber ?
+			Mesh::Attribute::FastWindingNumber : Mesh::Attribute::BVH;
+		mesh->Prefetch({ &insideTestStructure, 1 });
+	}
+
+	result.VertexCount = mesh->GetVertices().GetCount();
+	result.TriangleCount = mesh->GetTriangles().GetCount();
+	result.EdgeCount = mesh->GetEdgeCount();
+	result.IsClosed = mesh->IsClosed();
+	result.Statistics = mesh->GetStatistics();
+	result.MaxVertexError = mesh->GetVertices().GetMaxError();
+	result.MaxNormalError = RadToDeg(mesh->GetSmoothVertexNormals().GetMaxAngularError());
+
+	if (!m_Points.empty())
+		result.InsidePointCount = mesh->ArePointsInsideMesh(m_Points, m_Options.InsideTestOptions).Count();
+
+	if (!m_ConvertedFilepaths.empty())
+	{
+		const auto& convertedFilepath = m_ConvertedFilepaths[index];
+		const bool isSaved = m_Options.ConvertFormat == ConvertFormat::Obj
+			? Mesh::SaveToObjFile(convertedFilepath, *mesh)
+			: Mesh::SaveToFile(convertedFilepath, *mesh);
+
+		if (isSaved)
+			result.ConvertedFilepath = convertedFilepath;
+		else
+			result.Error = std::format("Could not save converted mesh to: \"{}\"", convertedFilepath.string());
+	}
+
+	result.MemoryBytes = mesh->GetMemoryUsage().GetTotal();
+
+	const auto allocations = allocationScope.Stop();
+	if (allocations.IsExclusive)
+	{
+		result.PeakHeapBytes = allocations.PeakBytes;
+		result.AllocationCount = allocations.AllocationCount;
+	}
+
+	result.Milliseconds = timer.GetElapsedMilliseconds();
+	return result;
+}
+
+bool BatchProcessor::SaveResultsAsJson(const fs::path& filepath) const
+{
+	json::StringBuffer jsonStringBuffer;
+	json::Writer<json::StringBuffer> jsonWriter(jsonStringBuffer);
+
+	jsonWriter.StartObject();
+	jsonWriter.Key("results");
+	jsonWriter.StartArray();
+	for (const auto& result : m_Results)
+	{
+		jsonWriter.StartObject();
+		jsonWriter.Key("path");
+		jsonWriter.String(result.Filepath.string().c_str());
+
+		if (!result.Error.empty())
+		{
+			jsonWriter.Key("error");
+			jsonWriter.String(result.Error.c_str());
+		}
+		else
+		{
+			jsonWriter.Key("vertices");
+			jsonWriter.Uint64(result.VertexCount);
+			jsonWriter.Key("triangles");
+			jsonWriter.Uint64(result.TriangleCount);
+			jsonWriter.Key("edges");
+			jsonWriter.Uint64(result.EdgeCount);
+			jsonWriter.Key("is_closed");
+			jsonWriter.Bool(result.IsClosed);
+			jsonWriter.Key("smallest_triangle_area");
+			jsonWriter.Double(result.Statistics.SmallestTriangleArea);
+			jsonWriter.Key("biggest_triangle_area");
+			jsonWriter.Double(result.Statistics.BiggestTriangleArea);
+			jsonWriter.Key("average_triangle_area");
+			jsonWriter.Double(result.Statistics.AverageTriangleArea);
+
+			if (result.MaxVertexError > 0.f)
+			{
+				jsonWriter.Key("max_vertex_error");
+				jsonWriter.Double(result.MaxVertexError);
+				jsonWriter.Key("max_normal_error_degrees");
+				jsonWriter.Double(result.MaxNormalError);
+			}
+
+			if (result.InsidePointCount)
+			{
+				jsonWriter.Key("inside_point_count");
+				jsonWriter.Uint64(*result.InsidePointCount);
+			}
+
+			if (!result.ConvertedFilepath.empty())
+			{
+				jsonWriter.Key("converted_path");
+				jsonWriter.String(result.ConvertedFilepath.string().c_str());
+			}
+
+			jsonWriter.Key("memory_bytes");
+			jsonWriter.Uint64(result.MemoryBytes);
+			jsonWriter.Key("peak_heap_bytes");
+			if (result.PeakHeapBytes)
+				jsonWriter.Uint64(*result.PeakHeapBytes);
+			else
+				jsonWriter.Null();
+
+			jsonWriter.Key("allocations");
+			if (result.AllocationCount)
+				jsonWriter.Uint64(*result.AllocationCount);
+			else
+				jsonWriter.Null();
+		}
+
+		jsonWriter.Key("milliseconds");
+		jsonWriter.Double(result.Milliseconds);
+		jsonWriter.EndObject();
+	}
+	jsonWriter.EndArray();
+	jsonWriter.EndObject();
+
+	return utils::WriteFile(filepath, jsonStringBuffer.GetString());
+}
+
+bool BatchProcessor::SaveResultsAsCsv(const fs::path& filepath) const
+{
+	std::string data = "path,error,vertices,triangles,edges,is_closed,smallest_triangle_area,biggest_triangle_area,average_triangle_area,max_vertex_error,max_normal_error_degrees,inside_point_count,converted_path,memory_bytes,peak_heap_bytes,allocations,milliseconds\n";
+
+	for (const auto& result : m_Results)
+	{
+		const auto insidePointCount = result.InsidePointCount ? std::to_string(*result.InsidePointCount) : std::string();
+		const auto peakHeapBytes = result.PeakHeapBytes ? std::to_string(*result.PeakHeapBytes) : std::string();
+		const auto allocationCount = result.AllocationCount ? std::to_string(*result.AllocationCount) : std::string();
+
+		std::format_to(std::back_inserter(data), "{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{:.3f}\n",
+			EscapeCsv(result.Filepath.string()), EscapeCsv(result.Error),
+			result.VertexCount, result.TriangleCount, result.EdgeCount, result.IsClosed,
+			result.Statistics.SmallestTriangleArea, result.Statistics.BiggestTriangleArea, result.Statistics.AverageTriangleArea,
+			result.MaxVertexError, result.MaxNormalError, insidePointCount, EscapeCsv(result.ConvertedFilepath.string()),
+			result.MemoryBytes, peakHeapBytes, allocationCount, result.Milliseconds);
+	}
+
+	return utils::WriteFile(filepath, data);
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Core/Mesh.h"
+
+// Processes many mesh files concurrently without a window, for the batch command
+class BatchProcessor
+{
+public:
+	enum class ConvertFormat : uint8_t
+	{
+		Json,
+		Obj
+	};
+
+	struct Options
+	{
+		std::vector<std::string> FilePatterns; // Files, directories or wildcard patterns
+		fs::path PointsPath; // Optional, points classified against every mesh
+		Mesh::InsideTestOptions InsideTestOptions;
+		Mesh::LoadOptions LoadOptions;
+		uint32_t SubdivisionCount = 0;
+		fs::path ConvertDirectory; // Optional, where the (subdivided) meshes are saved, mirroring the directories searched
+		BatchProcessor::ConvertFormat ConvertFormat = BatchProcessor::ConvertFormat::Json;
+		uint32_t ThreadCount = 0; // 0 for all cores
+	};
+
+	struct Result
+	{
+		fs::path Filepath;
+		std::string Error; // Empty on success
+
+		uint64_t VertexCount = 0;
+		uint64_t TriangleCount = 0;
+		uint64_t EdgeCount = 0;
+		bool IsClosed = false;
+		Mesh::Statistics Statistics;
+		float MaxVertexError = 0.f; // Of the compact storage, 0 for floats, see PositionBuffer::GetMaxError
+		float MaxNormalError = 0.f; // Degrees
+		std::optional<size_t> InsidePointCount;
+		fs::path ConvertedFilepath;
+
+		size_t MemoryBytes = 0; // Held by the mesh and its caches at the end
+		// Empty when another file was processed concurrently, the counters being process-wide
+		std::optional<size_t> PeakHeapBytes;
+		std::optional<uint64_t> AllocationCount;
+
+		double Milliseconds = 0.0;
+	};
+
+public:
+	// Finds the files and loads the points, errors are written to the standard error
+	static std::optional<BatchProcessor> Create(const BatchProcessor::Options& options);
+
+	void Run();
+
+	const std::vector<fs::path>& GetFilepaths() const;
+	const std::vector<BatchProcessor::Result>& GetResults() const;
+	size_t GetFailedCount() const;
+
+	// The format is chosen by the extension, ".csv" or JSON otherwise
+	bool SaveResults(const fs::path& filepath) const;
+
+private:
+	BatchProcessor(const BatchProcessor::Options& options, std::vector<fs::path>&& filepaths,
+		std::vector<fs::path>&& convertedFilepaths, std::vector<Vector3f>&& points);
+
+	BatchProcessor::Result ProcessFile(size_t index) const;
+
+	bool SaveResultsAsJson(const fs::path& filepath) const;
+	bool SaveResultsAsCsv(const fs::path& filepath) const;
+
+private:
+	BatchProcessor::Options m_Options;
+	std::vector<fs::path> m_Filepaths;
+	std::vector<fs::path> m_ConvertedFilepaths; // Empty without a convert directory
+	std::vector<Vector3f> m_Points;
+	std::vector<BatchProcessor::Result> m_Results;
+};
\ No newline at end of file
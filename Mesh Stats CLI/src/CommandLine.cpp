@@ -0,0 +1,288 @@
+#include "corepch.h"
+#include "CommandLine.h"
+
+#include "Core/PointsFile.h"
+#include "Utils/MemoryUtils.h"
+#include "Utils/TimeUtils.h"
+
+namespace
+{
+	bool ParseLogLevel(const std::string_view text)
+	{
+		const auto level = utils::Logger::ParseLevel(text);
+		if (!level) return false;
+
+		utils::Logger::SetLevel(*level);
+		return true;
+	}
+
+	template<typename T>
+	bool ParseNumber(const std::string_view text, T& value)
+	{
+		const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+		return error == std::errc() && end == text.data() + text.size();
+	}
+
+	void PrintMeshMemory(const Mesh& mesh)
+	{
+		const auto memoryUsage = mesh.GetMemoryUsage();
+		std::cout << std::format("Mesh memory: {} (vertices {}, triangles {}, smooth vertex normals {}, BVH {}, triangle records {}, fast winding number {}, classification grid {})",
+			utils::FormatBytes(memoryUsage.GetTotal()), utils::FormatBytes(memoryUsage.Vertices), utils::FormatBytes(memoryUsage.Triangles),
+			utils::FormatBytes(memoryUsage.SmoothVertexNormals), utils::FormatBytes(memoryUsage.BVH), utils::FormatBytes(memoryUsage.TriangleRecords),
+			utils::FormatBytes(memoryUsage.FastWindingNumber), utils::FormatBytes(memoryUsage.ClassificationGrid)) << std::endl;
+
+		const auto& constructionMemory = mesh.GetConstructionMemory();
+		if (!utils::IsAllocationTrackingEnabled() || !constructionMemory.IsExclusive)
+			return;
+
+		std::cout << std::format("Load peak: {}, {} allocations",
+			utils::FormatBytes(constructionMemory.LoadPeakBytes), constructionMemory.AllocationCount) << std::endl;
+	}
+
+	void PrintProcessMemory()
+	{
+		std::string text = std::format("Peak resident memory: {}", utils::FormatBytes(utils::GetPeakResidentMemory()));
+		if (utils::IsAllocationTrackingEnabled())
+		{
+			const auto counters = utils::GetAllocationCounters();
+			std::format_to(std::back_inserter(text), ", peak heap memory: {}, {} allocations",
+				utils::FormatBytes(counters.PeakBytes), counters.AllocationCount);
+		}
+
+		std::cout << text << std::endl;
+	}
+}
+
+/*static*/ int CommandLine::Run(const int argc, const char* const* const argv)
+{
+	const std::vector<std::string_view> args(argv + 1, argv + argc);
+
+	if (args.size() >= 4 && args[0] == "classify")
+	{
+		Mesh::InsideTestOptions insideTestOptions;
+		uint32_t classificationGridResolution = 0;
+
+		for (size_t i = 4; i < args.size(); ++i)
+		{
+			const bool hasValue = i + 1 < args.size() && !args[i + 1].starts_with("--");
+
+			if (args[i] == "--winding-number")
+			{
+				insideTestOptions.Mode = Mesh::InsideTestMode::WindingNumber;
+				if (hasValue && !ParseNumber(args[++i], insideTestOptions.WindingNumberAccuracy))
+				{
+					PrintUsage();
+					return EXIT_FAILURE;
+				}
+			}
+			else if (args[i] == "--grid")
+			{
+				classificationGridResolution = ClassificationGrid::DEFAULT_RESOLUTION;
+				if (hasValue && !ParseNumber(args[++i], classificationGridResolution))
+				{
+					PrintUsage();
+					return EXIT_FAILURE;
+				}
+			}
+			else if (args[i] == "--log-level" && hasValue)
+			{
+				if (!ParseLogLevel(args[++i]))
+				{
+					PrintUsage();
+					return EXIT_FAILURE;
+				}
+			}
+			else
+			{
+				PrintUsage();
+				return EXIT_FAILURE;
+			}
+		}
+
+		return ClassifyPoints(args[1], args[2], args[3], insideTestOptions, classificationGridResolution);
+	}
+
+	if (args.size() >= 2 && args[0] == "batch")
+	{
+		BatchProcessor::Options options;
+		fs::path outputPath;
+
+		for (size_t i = 1; i < args.size(); ++i)
+		{
+			const bool hasValue = i + 1 < args.size() && !args[i + 1].starts_with("--");
+
+			bool isValid = true;
+			if (!args[i].starts_with("--"))
+			{
+				options.FilePatterns.emplace_back(args[i]);
+			}
+			else if (args[i] == "--output" && hasValue)
+			{
+				outputPath = args[++i];
+			}
+			else if (args[i] == "--points" && hasValue)
+			{
+				options.PointsPath = args[++i];
+			}
+			else if (args[i] == "--winding-number")
+			{
+				options.InsideTestOptions.Mode = Mesh::InsideTestMode::WindingNumber;
+				if (hasValue)
+					isValid = ParseNumber(args[++i], options.InsideTestOptions.WindingNumberAccuracy);
+			}
+			else if (args[i] == "--reorder")
+			{
+				options.LoadOptions.ReorderForLocality = true;
+			}
+			else if (args[i] == "--compact")
+			{
+				options.LoadOptions.VertexEncoding = PositionBuffer::Encoding::Quantized21;
+				if (hasValue)
+				{
+					const auto bits = args[++i];
+					isValid = bits == "16" || bits == "21";
+					if (bits == "16")
+						options.LoadOptions.VertexEncoding = PositionBuffer::Encoding::Quantized16;
+				}
+			}
+			else if (args[i] == "--subdivide" && hasValue)
+			{
+				isValid = ParseNumber(args[++i], options.SubdivisionCount);
+			}
+			else if (args[i] == "--convert" && hasValue)
+			{
+				options.ConvertDirectory = args[++i];
+			}
+			else if (args[i] == "--format" && hasValue)
+			{
+				const auto format = args[++i];
+				isValid = format == "json" || format == "obj";
+				options.ConvertFormat = format == "obj" ? BatchProcessor::ConvertFormat::Obj : BatchProcessor::ConvertFormat::Json;
+			}
+			else if (args[i] == "--threads" && hasValue)
+			{
+				isValid = ParseNumber(args[++i], options.ThreadCount);
+			}
+			else if (args[i] == "--log-level" && hasValue)
+			{
+				isValid = ParseLogLevel(args[++i]);
+			}
+			else
+			{
+				isValid = false;
+			}
+
+			if (!isValid)
+			{
+				PrintUsage();
+				return EXIT_FAILURE;
+			}
+		}
+
+		return ProcessBatch(options, outputPath);
+	}
+
+	PrintUsage();
+	return EXIT_FAILURE;
+}
+
+/*static*/ int CommandLine::ProcessBatch(const BatchProcessor::Options& options, const fs::path& outputPath)
+{
+	auto batchProcessor = BatchProcessor::Create(options);
+	if (!batchProcessor)
+		return EXIT_FAILURE;
+
+	const utils::Timer timer;
+	batchProcessor->Run();
+	const double elapsedSeconds = timer.GetElapsedSeconds();
+
+	for (const auto& result : batchProcessor->GetResults())
+	{
+		if (!result.Error.empty())
+		{
+			std::cerr << std::format("{}: {}", result.Filepath.string(), result.Error) << std::endl;
+			continue;
+		}
+
+		std::cout << std::format("{}: {} vertices, {} triangles, {} edges, {}, average triangle area {}{}{}",
+			result.Filepath.string(), result.VertexCount, result.TriangleCount, result.EdgeCount,
+			result.IsClosed ? "closed" : "open", result.Statistics.AverageTriangleArea,
+			result.MaxVertexError > 0.f ? std::format(", vertex error up to {:.3g}, normal error up to {:.3g} degrees", result.MaxVertexError, result.MaxNormalError) : std::string(),
+			result.InsidePointCount ? std::format(", {} points inside", *result.InsidePointCount) : std::string()) << std::endl;
+	}
+
+	const size_t fileCount = batchProcessor->GetFilepaths().size();
+	const size_t failedCount = batchProcessor->GetFailedCount();
+	std::cout << std::format("Processed {} files in {:.3f} s ({:.1f} files/s), {} failed",
+		fileCount, elapsedSeconds, fileCount / elapsedSeconds, failedCount) << std::endl;
+	PrintProcessMemory();
+
+	if (!outputPath.empty() && !batchProcessor->SaveResults(outputPath))
+	{
+		std::cerr << std::format("Could not save results to: \"{}\"", outputPath.string()) << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return failedCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*static*/ int CommandLine::ClassifyPoints(const fs::path& meshPath, const fs::path& pointsPath, const fs::path& resultsPath,
+	const Mesh::InsideTestOptions& insideTestOptions, const uint32_t classificationGridResolution)
+{
+	const auto mesh = Mesh::LoadFromFile(meshPath);
+	if (!mesh)
+	{
+		std::cerr << std::format("File does not exist or has incorrect format: \"{}\"", meshPath.string()) << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const auto points = PointsFile::LoadPoints(pointsPath);
+	if (!points)
+	{
+		std::cerr << std::format("File does not exist or has incorrect format: \"{}\"", pointsPath.string()) << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (classificationGridResolution > 0)
+	{
+		const auto grid = mesh->BuildClassificationGrid(classificationGridResolution);
+		const auto& cellCounts = grid->GetCellCounts();
+		std::cout << std::format("Built {}x{}x{} classification grid in {:.3f} ms ({} bytes)",
+			cellCounts[0], cellCounts[1], cellCounts[2], grid->GetBuildTime(), grid->GetMemoryUsage()) << std::endl;
+
+		if (!mesh->IsClosed())
+			std::cerr << "The mesh is not closed, the classification grid will not be used" << std::endl;
+	}
+
+	const utils::Timer timer;
+	const auto arePointsInside = mesh->ArePointsInsideMesh(*points, insideTestOptions);
+	const double elapsedSeconds = timer.GetElapsedSeconds();
+
+	std::cout << std::format("Checked {} points in {:.3f} ms ({:.0f} queries/s), {} inside mesh",
+		points->size(), elapsedSeconds * 1000.0, points->size() / elapsedSeconds, arePointsInside.Count()) << std::endl;
+	PrintMeshMemory(*mesh);
+	PrintProcessMemory();
+
+	if (!PointsFile::SaveResults(resultsPath, arePointsInside))
+	{
+		std::cerr << std::format("Could not save results to: \"{}\"", resultsPath.string()) << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+
+/*static*/ void CommandLine::PrintUsage()
+{
+	std::cout << "Usage:\n"
+		<< "  \"Mesh Stats CLI\" classify <mesh.json> <points.json> <out.json> [--winding-number [accuracy]] [--grid [resolution]]\n"
+		<< "      [--log-level info|warning|error|none]\n"
+		<< "      Check which points are inside the mesh, by ray parity or by generalized winding number\n"
+		<< "      --grid answers ray parity queries away from the surface of closed meshes from a precomputed voxel grid\n"
+		<< "  \"Mesh Stats CLI\" batch <files, directories or patterns...> [--output <results.json|results.csv>]\n"
+		<< "      [--points <points.json> [--winding-number [accuracy]]] [--reorder] [--compact [16|21]] [--subdivide <count>]\n"
+		<< "      [--convert <directory> [--format json|obj]] [--threads <count>] [--log-level info|warning|error|none]\n"
+		<< "      Compute the statistics of many meshes in parallel, optionally classify points, subdivide and convert them\n"
+		<< "      --compact stores the vertices quantized to 16 or 21 (default) bits per axis and the normals octahedral-encoded"
+		<< std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "BatchProcessor.h"
+#include "Core/Mesh.h"
+
+// Headless entry point of the Mesh Stats CLI
+class CommandLine
+{
+public:
+	static int Run(const int argc, const char* const* const argv);
+
+private:
+	static int ClassifyPoints(const fs::path& meshPath, const fs::path& pointsPath, const fs::path& resultsPath,
+		const Mesh::InsideTestOptions& insideTestOptions, const uint32_t classificationGridResolution);
+
+	static int ProcessBatch(const BatchProcessor::Options& options, const fs::path& outputPath);
+
+	static void PrintUsage();
+};
\ No newline at end of file
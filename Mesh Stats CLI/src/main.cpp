@@ -0,0 +1,9 @@
+#include "corepch.h"
+
+#include "CommandLine.h"
+#include "Utils/AllocationHooks.h"
+
+int main(int argc, char** argv)
+{
+	return CommandLine::Run(argc, argv);
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+project "Mesh Stats Core"
+    kind "StaticLib"
+    language "C++"
+    cppdialect "C++20"
+    staticruntime "on"
+
+    targetdir (BinDir)
+    objdir (ObjDir)
+
+    pchheader "corepch.h"
+    pchsource "src/corepch.cpp"
+
+    files
+    {
+        "src/**.h",
+        "src/**.cpp",
+        "vendor/**.h"
+    }
+
+    includedirs
+    {
+        "src",
+        "vendor"
+    }
+
+    defines
+    {
+        "_SILENCE_CXX17_ITERATOR_BASE_CLASS_DEPRECATION_WARNING"
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+
+    filter "system:linux"
+        pic "On"
+
+    filter "configurations:Debug"
+        runtime "Debug"
+        defines "DEBUG"
+        optimize "Off"
+        symbols "On"
+
+    filter "configurations:Release"
+        runtime "Release"
+        defines "RELEASE"
+        optimize "On"
+        symbols "Off"
\ No newline at end of file
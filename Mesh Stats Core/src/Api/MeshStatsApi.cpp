@@ -0,0 +1,294 @@
+#include "corepch.h"
+#include "Api/MeshStatsApi.h"
+
+#include "Core/Mesh.h"
+
+// The buffers of the interface are reinterpreted as vectors and triangles
+static_assert(sizeof(Vector3f) == 3 * sizeof(float) && std::is_standard_layout_v<Vector3f>);
+static_assert(sizeof(Triangle32) == 3 * sizeof(uint32_t) && std::is_standard_layout_v<Triangle32>);
+
+struct MsMesh
+{
+	explicit MsMesh(Mesh&& mesh)
+		: Value(std::move(mesh))
+	{
+	}
+
+	Mesh Value;
+
+	// Subdivided meshes share the vertices of the mesh they subdivide, the interface reads them from one copy
+	mutable std::once_flag CopiedVerticesOnceFlag;
+	mutable std::vector<Vector3f> CopiedVertices;
+};
+
+namespace
+{
+	// Exceptions must not cross the C interface
+	template<typename Function>
+	MsResult Call(Function&& function)
+	{
+		try
+		{
+			return function();
+		}
+		catch (const std::bad_alloc&)
+		{
+			return MS_ERROR_OUT_OF_MEMORY;
+		}
+		catch (...)
+		{
+			return MS_ERROR_INTERNAL;
+		}
+	}
+
+	std::span<const Vector3f> GetPoints(const float* const points, const size_t pointCount)
+	{
+		return { reinterpret_cast<const Vector3f*>(points), pointCount };
+	}
+
+	Mesh::InsideTestOptions GetInsideTestOptions(const MsInsideTestOptions* const options)
+	{
+		Mesh::InsideTestOptions insideTestOptions;
+		if (!options) return insideTestOptions;
+
+		insideTestOptions.Mode = options->Mode == MS_INSIDE_TEST_WINDING_NUMBER ? Mesh::InsideTestMode::WindingNumber : Mesh::InsideTestMode::RayParity;
+		insideTestOptions.WindingNumberAccuracy = options->WindingNumberAccuracy;
+		return insideTestOptions;
+	}
+
+	template<typename Index>
+	void CopyVertexIndexes(const TriangleBuffer& triangles, Index* const vertexIndexes)
+	{
+		triangles.Visit(
+			[vertexIndexes](const auto& typedTriangles) -> void
+			{
+				for (size_t i = 0; i < typedTriangles.size(); ++i)
+				{
+					for (size_t j = 0; j < 3; ++j)
+						vertexIndexes[3 * i + j] = static_cast<Index>(typedTriangles[i].VertexIndexes[j]);
+				}
+			}
+		);
+	}
+
+	bool AreQueryArgumentsValid(const MsMesh* const mesh, const float* const points, const size_t pointCount, const void* const results)
+	{
+		return mesh && (pointCount == 0 || (points && results)) && pointCount <= std::numeric_limits<uint32_t>::max();
+	}
+}
+
+const char* ms_result_to_string(const MsResult result)
+{
+	switch (result)
+	{
+	case MS_SUCCESS: return "Success";
+	case MS_ERROR_INVALID_ARGUMENT: return "Invalid argument";
+	case MS_ERROR_FILE: return "File does not exist or has incorrect format";
+	case MS_ERROR_OUT_OF_MEMORY: return "Out of memory";
+	case MS_ERROR_INTERNAL: return "Internal error";
+	default: return "Unknown result";
+	}
+}
+
+MsInsideTestOptions ms_default_inside_test_options(void)
+{
+	return { MS_INSIDE_TEST_RAY_PARITY, FastWindingNumber::DEFAULT_ACCURACY };
+}
+
+MsResult ms_mesh_create(const float* const vertices, const size_t vertexCount, const uint32_t* const triangles, const size_t triangleCount, MsMesh** const mesh)
+{
+	if (!vertices || !triangles || !mesh || vertexCount == 0 || triangleCount == 0 || vertexCount > std::numeric_limits<uint32_t>::max())
+		return MS_ERROR_INVALID_ARGUMENT;
+
+	const std::span<const Triangle32> triangleSpan(reinterpret_cast<const Triangle32*>(triangles), triangleCount);
+	for (const auto& triangle : triangleSpan)
+	{
+		for (const uint32_t vertexIndex : triangle.VertexIndexes)
+		{
+			if (vertexIndex >= vertexCount)
+				return MS_ERROR_INVALID_ARGUMENT;
+		}
+	}
+
+	return Call([&]() -> MsResult
+		{
+			*mesh = new MsMesh(Mesh(
+				std::vector<Vector3f>(reinterpret_cast<const Vector3f*>(vertices), reinterpret_cast<const Vector3f*>(vertices) + vertexCount),
+				std::vector<Triangle32>(triangleSpan.begin(), triangleSpan.end())));
+			return MS_SUCCESS;
+		}
+	);
+}
+
+MsResult ms_mesh_load(const char* const filepath, MsMesh** const mesh)
+{
+	if (!filepath || !mesh)
+		return MS_ERROR_INVALID_ARGUMENT;
+
+	return Call([&]() -> MsResult
+		{
+			auto loadedMesh = Mesh::LoadFromFile(filepath);
+			if (!loadedMesh)
+				return MS_ERROR_FILE;
+
+			*mesh = new MsMesh(std::move(*loadedMesh));
+			return MS_SUCCESS;
+		}
+	);
+}
+
+MsResult ms_mesh_save(const MsMesh* const mesh, const char* const filepath)
+{
+	if (!mesh || !filepath)
+		return MS_ERROR_INVALID_ARGUMENT;
+
+	return Call([&]() -> MsResult
+		{
+			const fs::path path(filepath);
+			const bool isSaved = path.extension() == ".obj" ? Mesh::SaveToObjFile(path, mesh->Value) : Mesh::SaveToFile(path, mesh->Value);
+			return isSaved ? MS_SUCCESS : MS_ERROR_FILE;
+		}
+	);
+}
+
+MsResult ms_mesh_subdivide(const MsMesh* const mesh, MsMesh** const subdividedMesh)
+{
+	if (!mesh || !subdividedMesh)
+		return MS_ERROR_INVALID_ARGUMENT;
+
+	return Call([&]() -> MsResult
+		{
+			*subdividedMesh = new MsMesh(mesh->Value.GenerateSubdividedMesh());
+			return MS_SUCCESS;
+		}
+	);
+}
+
+void ms_mesh_destroy(MsMesh* const mesh)
+{
+	delete mesh;
+}
+
+size_t ms_mesh_get_vertex_count(const MsMesh* const mesh)
+{
+	return mesh ? mesh->Value.GetVertices().GetCount() : 0;
+}
+
+const float* ms_mesh_get_vertices(const MsMesh* const mesh)
+{
+	if (!mesh) return nullptr;
+
+	const auto& vertices = mesh->Value.GetVertices();
+	if (const Vector3f* const data = vertices.GetData())
+		return reinterpret_cast<const float*>(data);
+
+	const MsResult result = Call([&]() -> MsResult
+		{
+			std::call_once(mesh->CopiedVerticesOnceFlag, [&]() -> void { mesh->CopiedVertices = vertices.Decode(); });
+			return MS_SUCCESS;
+		}
+	);
+
+	return result == MS_SUCCESS ? reinterpret_cast<const float*>(mesh->CopiedVertices.data()) : nullptr;
+}
+
+const float* ms_mesh_get_smooth_vertex_normals(const MsMesh* const mesh)
+{
+	if (!mesh) return nullptr;
+
+	// Computed on first access, the failure of the computation is rethrown
+	const Vector3f* normals = nullptr;
+	const MsResult result = Call([&]() -> MsResult
+		{
+			normals = mesh->Value.GetSmoothVertexNormals().GetData();
+			return MS_SUCCESS;
+		}
+	);
+
+	return result == MS_SUCCESS ? reinterpret_cast<const float*>(normals) : nullptr;
+}
+
+size_t ms_mesh_get_triangle_count(const MsMesh* const mesh)
+{
+	return mesh ? mesh->Value.GetTriangles().GetCount() : 0;
+}
+
+MsResult ms_mesh_get_triangles(const MsMesh* const mesh, uint32_t* const triangles)
+{
+	if (!mesh || !triangles || mesh->Value.GetTriangles().GetIndexSize() > sizeof(uint32_t))
+		return MS_ERROR_INVALID_ARGUMENT;
+
+	CopyVertexIndexes(mesh->Value.GetTriangles(), triangles);
+	return MS_SUCCESS;
+}
+
+MsResult ms_mesh_get_triangles_64(const MsMesh* const mesh, uint64_t* const triangles)
+{
+	if (!mesh || !triangles)
+		return MS_ERROR_INVALID_ARGUMENT;
+
+	CopyVertexIndexes(mesh->Value.GetTriangles(), triangles);
+	return MS_SUCCESS;
+}
+
+MsResult ms_mesh_get_statistics(const MsMesh* const mesh, MsStatistics* const statistics)
+{
+	if (!mesh || !statistics)
+		return MS_ERROR_INVALID_ARGUMENT;
+
+	return Call([&]() -> MsResult
+		{
+			// Computed on first access, the failures of the computations are rethrown
+			const auto& meshStatistics = mesh->Value.GetStatistics();
+			statistics->SmallestTriangleArea = meshStatistics.SmallestTriangleArea;
+			statistics->BiggestTriangleArea = meshStatistics.BiggestTriangleArea;
+			statistics->AverageTriangleArea = meshStatistics.AverageTriangleArea;
+			statistics->EdgeCount = mesh->Value.GetEdgeCount();
+			statistics->IsClosed = mesh->Value.IsClosed() ? 1 : 0;
+			return MS_SUCCESS;
+		}
+	);
+}
+
+MsResult ms_mesh_are_points_inside(const MsMesh* const mesh, const float* const points, const size_t pointCount, const MsInsideTestOptions* const options, uint8_t* const areInside)
+{
+	if (!AreQueryArgumentsValid(mesh, points, pointCount, areInside))
+		return MS_ERROR_INVALID_ARGUMENT;
+
+	return Call([&]() -> MsResult
+		{
+			// The results are bit-packed internally, they are expanded to one byte per point here
+			const auto arePointsInside = mesh->Value.ArePointsInsideMesh(GetPoints(points, pointCount), GetInsideTestOptions(options));
+			for (size_t i = 0; i < pointCount; ++i)
+				areInside[i] = arePointsInside[i] ? 1 : 0;
+
+			return MS_SUCCESS;
+		}
+	);
+}
+
+MsResult ms_mesh_signed_distances(const MsMesh* const mesh, const float* const points, const size_t pointCount, const MsInsideTestOptions* const options, float* const signedDistances)
+{
+	if (!AreQueryArgumentsValid(mesh, points, pointCount, signedDistances))
+		return MS_ERROR_INVALID_ARGUMENT;
+
+	return Call([&]() -> MsResult
+		{
+			mesh->Value.SignedDistances(GetPoints(points, pointCount), GetInsideTestOptions(options), std::span<float>(signedDistances, pointCount));
+			return MS_SUCCESS;
+		}
+	);
+}
+
+MsResult ms_mesh_closest_points(const MsMesh* const mesh, const float* const points, const size_t pointCount, float* const closestPoints)
+{
+	if (!AreQueryArgumentsValid(mesh, points, pointCount, closestPoints))
+		return MS_ERROR_INVALID_ARGUMENT;
+
+	return Call([&]() -> MsResult
+		{
+			mesh->Value.ClosestPoints(GetPoints(points, pointCount), std::span<Vector3f>(reinterpret_cast<Vector3f*>(closestPoints), pointCount));
+			return MS_SUCCESS;
+		}
+	);
+}
\ No newline at end of file
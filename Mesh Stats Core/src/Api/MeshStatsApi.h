@@ -0,0 +1,82 @@
+#pragma once
+
+// C interface of the core library, usable without the C++ headers
+// Point, vertex and normal buffers are tightly packed x, y, z floats, triangles are 3 packed vertex indexes
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct MsMesh MsMesh;
+
+typedef enum MsResult
+{
+	MS_SUCCESS = 0,
+	MS_ERROR_INVALID_ARGUMENT,
+	MS_ERROR_FILE,
+	MS_ERROR_OUT_OF_MEMORY,
+	MS_ERROR_INTERNAL
+} MsResult;
+
+typedef enum MsInsideTestMode
+{
+	MS_INSIDE_TEST_RAY_PARITY = 0,
+	MS_INSIDE_TEST_WINDING_NUMBER
+} MsInsideTestMode;
+
+typedef struct MsInsideTestOptions
+{
+	MsInsideTestMode Mode;
+	float WindingNumberAccuracy;
+} MsInsideTestOptions;
+
+typedef struct MsStatistics
+{
+	float SmallestTriangleArea;
+	float BiggestTriangleArea;
+	float AverageTriangleArea;
+	uint64_t EdgeCount;
+	int32_t IsClosed;
+} MsStatistics;
+
+const char* ms_result_to_string(MsResult result);
+
+// Defaults used when NULL is passed as the inside test options
+MsInsideTestOptions ms_default_inside_test_options(void);
+
+// The buffers are copied once into the mesh, every other call reads and writes the caller's buffers in place
+MsResult ms_mesh_create(const float* vertices, size_t vertexCount, const uint32_t* triangles, size_t triangleCount, MsMesh** mesh);
+MsResult ms_mesh_load(const char* filepath, MsMesh** mesh);
+MsResult ms_mesh_save(const MsMesh* mesh, const char* filepath); // Wavefront OBJ if the extension is .obj, JSON otherwise
+MsResult ms_mesh_subdivide(const MsMesh* mesh, MsMesh** subdividedMesh);
+void ms_mesh_destroy(MsMesh* mesh);
+
+// The returned buffers are owned by the mesh and stay valid until it is destroyed
+// The meshes created here always store their vertices and normals as floats, so these are never NULL for a valid mesh
+// unless the copy of the vertices or the computation of the normals (on first access) fails, out of memory for instance
+// Subdivided meshes share the vertices of the mesh they subdivide, their first ms_mesh_get_vertices copies them into one buffer
+size_t ms_mesh_get_vertex_count(const MsMesh* mesh);
+const float* ms_mesh_get_vertices(const MsMesh* mesh);
+const float* ms_mesh_get_smooth_vertex_normals(const MsMesh* mesh);
+size_t ms_mesh_get_triangle_count(const MsMesh* mesh);
+
+// The mesh stores the vertex indexes with the narrowest type for its vertex count, so the triangles are copied out
+// into a buffer of 3 * triangle count indexes, uint32_t fails with MS_ERROR_INVALID_ARGUMENT past 2^32 vertices
+MsResult ms_mesh_get_triangles(const MsMesh* mesh, uint32_t* triangles);
+MsResult ms_mesh_get_triangles_64(const MsMesh* mesh, uint64_t* triangles);
+
+// Computed on first access, fails with MS_ERROR_OUT_OF_MEMORY or MS_ERROR_INTERNAL if the computation does
+MsResult ms_mesh_get_statistics(const MsMesh* mesh, MsStatistics* statistics);
+
+// Results hold one element per point: 0 or 1, signed distances negative inside the mesh, and closest points as x, y, z
+MsResult ms_mesh_are_points_inside(const MsMesh* mesh, const float* points, size_t pointCount, const MsInsideTestOptions* options, uint8_t* areInside);
+MsResult ms_mesh_signed_distances(const MsMesh* mesh, const float* points, size_t pointCount, const MsInsideTestOptions* options, float* signedDistances);
+MsResult ms_mesh_closest_points(const MsMesh* mesh, const float* points, size_t pointCount, float* closestPoints);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,435 @@
+#include "corepch.h"
+#include "Core/BVH.h"
+
+#include "Math/Geometry.h"
+#include "Utils/ThreadUtils.h"
+#include "Utils/TimeUtils.h"
+
+namespace
+{
+	constexpr uint32_t BIN_COUNT = 16;
+	constexpr uint32_t MAX_LEAF_TRIANGLE_COUNT = TRIANGLE_BLOCK_SIZE;
+	constexpr uint32_t MAX_DEPTH = 64; // Also the size of the traversal stack
+
+	// Subtrees with more triangles than this are built on a separate thread, down to BuildData::MaxParallelDepth
+	constexpr uint32_t PARALLEL_BUILD_THRESHOLD = 1 << 14;
+
+	// Cost of visiting a node relative to the cost of a ray-triangle test
+	constexpr float TRAVERSAL_COST = 1.f;
+
+	struct Bin
+	{
+		AABBf Bounds;
+		uint32_t TriangleCount = 0;
+	};
+}
+
+bool BVH::Node::IsLeaf() const
+{
+	return TriangleCount > 0;
+}
+
+BVH::BVH(const PositionBuffer& vertices, const TriangleBuffer& triangles)
+	: m_Depth(0)
+	, m_BuildTime(0.0)
+{
+	Build(vertices, triangles);
+}
+
+void BVH::Build(const PositionBuffer& vertices, const TriangleBuffer& triangles)
+{
+	PROFILE_SCOPE("BVH::Build");
+
+	// The nodes address the triangles with 32-bit indexes, whatever the width of the vertex indexes
+	ASSERT(triangles.GetCount() > 0 && triangles.GetCount() <= std::numeric_limits<uint32_t>::max());
+
+	const utils::Timer timer;
+	const uint32_t triangleCount = static_cast<uint32_t>(triangles.GetCount());
+
+	BuildData buildData;
+	// Each parallel level doubles the threads, so about one subtree per core is built concurrently
+	buildData.MaxParallelDepth = static_cast<uint32_t>(std::bit_width(utils::GetThreadCount() - 1));
+	buildData.TriangleBounds.resize(triangleCount);
+	buildData.TriangleCentroids.resize(triangleCount);
+
+	vertices.Visit(
+		[&](const auto& typedVertices) -> void
+		{
+			triangles.Visit(
+				[&](const auto& typedTriangles) -> void
+				{
+					utils::ParallelFor(triangleCount,
+						[&](const size_t startIndex, const size_t endIndex) -> void
+						{
+							for (size_t i = startIndex; i < endIndex; ++i)
+							{
+								auto& bounds = buildData.TriangleBounds[i];
+								for (const auto vertexIndex : typedTriangles[i].VertexIndexes)
+									bounds.Extend(typedVertices[vertexIndex]);
+
+								buildData.TriangleCentroids[i] = bounds.GetCenter();
+							}
+						}
+					);
+				}
+			);
+		}
+	);
+
+	m_TriangleIndexes.resize(triangleCount);
+	std::iota(m_TriangleIndexes.begin(), m_TriangleIndexes.end(), 0);
+
+	// A binary tree with N leaves has 2N - 1 nodes
+	m_Nodes.resize(2 * static_cast<size_t>(triangleCount) - 1);
+	buildData.NodeCount = 1;
+
+	BuildNode(buildData, 0, 0, triangleCount, 1);
+
+	m_Nodes.resize(buildData.NodeCount);
+	m_Nodes.shrink_to_fit();
+	m_TriangleRecords.emplace(vertices, triangles, m_TriangleIndexes);
+	m_Depth = buildData.Depth;
+	m_BuildTime = timer.GetElapsedMilliseconds();
+
+	LOG_INFO("Built BVH over {} triangles: {} nodes, depth {}, {} ms", triangleCount, m_Nodes.size(), m_Depth, m_BuildTime);
+}
+
+void BVH::BuildNode(BVH::BuildData& buildData, const uint32_t nodeIndex, const uint32_t firstIndex, const uint32_t count, const uint32_t depth)
+{
+	auto& node = m_Nodes[nodeIndex];
+
+	AABBf centroidBounds;
+	for (uint32_t i = firstIndex; i < firstIndex + count; ++i)
+	{
+		const uint32_t triangleIndex = m_TriangleIndexes[i];
+		node.Bounds.Extend(buildData.TriangleBounds[triangleIndex]);
+		centroidBounds.Extend(buildData.TriangleCentroids[triangleIndex]);
+	}
+
+	const auto makeLeaf = [&]() -> void
+		{
+			node.FirstIndex = firstIndex;
+			node.TriangleCount = count;
+
+			uint32_t currentDepth = buildData.Depth;
+			while (currentDepth < depth && !buildData.Depth.compare_exchange_weak(currentDepth, depth));
+		};
+
+	if (count <= MAX_LEAF_TRIANGLE_COUNT || depth >= MAX_DEPTH)
+	{
+		makeLeaf();
+		return;
+	}
+
+	// Find the cheapest split plane among the bin boundaries of all three axes
+	float bestCost = std::numeric_limits<float>::max();
+	uint32_t bestAxis = 0;
+	uint32_t bestSplitBin = 0;
+
+	const auto centroidExtent = centroidBounds.GetExtent();
+	for (uint32_t axis = 0; axis < 3; ++axis)
+	{
+		const float axisMin = centroidBounds.Min[axis];
+		const float axisExtent = centroidExtent[axis];
+		if (axisExtent <= 0.f) continue;
+
+		const float binScale = BIN_COUNT / axisExtent;
+
+		std::array<Bin, BIN_COUNT> bins;
+		for (uint32_t i = firstIndex; i < firstIndex + count; ++i)
+		{
+			const uint32_t triangleIndex = m_TriangleIndexes[i];
+			const float centroid = buildData.TriangleCentroids[triangleIndex][axis];
+			const uint32_t binIndex = std::min(BIN_COUNT - 1, static_cast<uint32_t>((centroid - axisMin) * binScale));
+
+			bins[binIndex].Bounds.Extend(buildData.TriangleBounds[triangleIndex]);
+			++bins[binIndex].TriangleCount;
+		}
+
+		// Sweep from the right to get the cost of every right side, then from the left to combine both sides
+		std::array<float, BIN_COUNT - 1> rightCosts;
+		AABBf rightBounds;
+		uint32_t rightCount = 0;
+		for (uint32_t i = BIN_COUNT - 1; i > 0; --i)
+		{
+			rightBounds.Extend(bins[i].Bounds);
+			rightCount += bins[i].TriangleCount;
+			rightCosts[i - 1] = rightCount > 0 ? rightBounds.GetSurfaceArea() * rightCount : 0.f;
+		}
+
+		AABBf leftBounds;
+		uint32_t leftCount = 0;
+		for (uint32_t i = 0; i < BIN_COUNT - 1; ++i)
+		{
+			leftBounds.Extend(bins[i].Bounds);
+			leftCount += bins[i].TriangleCount;
+			if (leftCount == 0 || leftCount == count) continue;
+
+			const float cost = leftBounds.GetSurfaceArea() * leftCount + rightCosts[i];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplitBin = i + 1;
+			}
+		}
+	}
+
+	const float nodeSurfaceArea = node.Bounds.GetSurfaceArea();
+	const bool hasSplit = bestCost < std::numeric_limits<float>::max();
+	const float splitCost = nodeSurfaceArea > 0.f ? TRAVERSAL_COST + bestCost / nodeSurfaceArea : bestCost;
+
+	uint32_t leftCount = 0;
+	if (hasSplit)
+	{
+		// Splitting is not worth it, unless the leaf would become too big
+		if (splitCost >= count && count <= 4 * MAX_LEAF_TRIANGLE_COUNT)
+		{
+			makeLeaf();
+			return;
+		}
+
+		const float axisMin = centroidBounds.Min[bestAxis];
+		const float binScale = BIN_COUNT / centroidExtent[bestAxis];
+
+		const auto middle = std::partition(m_TriangleIndexes.begin() + firstIndex, m_TriangleIndexes.begin() + firstIndex + count,
+			[&](const uint32_t triangleIndex) -> bool
+			{
+				const float centroid = buildData.TriangleCentroids[triangleIndex][bestAxis];
+				return std::min(BIN_COUNT - 1, static_cast<uint32_t>((centroid - axisMin) * binScale)) < bestSplitBin;
+			}
+		);
+
+		leftCount = static_cast<uint32_t>(middle - (m_TriangleIndexes.begin() + firstIndex));
+	}
+
+	// All centroids coincide: the triangles cannot be separated spatially, so split the range in half
+	if (leftCount == 0 || leftCount == count)
+		leftCount = count / 2;
+
+	const uint32_t leftChildIndex = buildData.NodeCount.fetch_add(2);
+	node.FirstIndex = leftChildIndex;
+	node.TriangleCount = 0;
+
+	if (count > PARALLEL_BUILD_THRESHOLD && depth <= buildData.MaxParallelDepth)
+	{
+		auto leftFuture = std::async(std::launch::async,
+			&BVH::BuildNode, this, std::ref(buildData), leftChildIndex, firstIndex, leftCount, depth + 1);
+
+		BuildNode(buildData, leftChildIndex + 1, firstIndex + leftCount, count - leftCount, depth + 1);
+		leftFuture.get();
+	}
+	else
+	{
+		BuildNode(buildData, leftChildIndex, firstIndex, leftCount, depth + 1);
+		BuildNode(buildData, leftChildIndex + 1, firstIndex + leftCount, count - leftCount, depth + 1);
+	}
+}
+
+const std::vector<BVH::Node>& BVH::GetNodes() const
+{
+	return m_Nodes;
+}
+
+const std::vector<uint32_t>& BVH::GetTriangleIndexes() const
+{
+	return m_TriangleIndexes;
+}
+
+const TriangleRecords& BVH::GetTriangleRecords() const
+{
+	return *m_TriangleRecords;
+}
+
+uint32_t BVH::GetDepth() const
+{
+	return m_Depth;
+}
+
+double BVH::GetBuildTime() const
+{
+	return m_BuildTime;
+}
+
+size_t BVH::GetMemoryUsage() const
+{
+	return sizeof(BVH)
+		+ m_Nodes.capacity() * sizeof(BVH::Node)
+		+ m_TriangleIndexes.capacity() * sizeof(uint32_t)
+		+ (m_TriangleRecords ? m_TriangleRecords->GetMemoryUsage() - sizeof(TriangleRecords) : 0);
+}
+
+uint32_t BVH::CountRayIntersections(const Ray3f& ray) const
+{
+	const Vector3f inverseDirection = { 1.f / ray.Direction.x, 1.f / ray.Direction.y, 1.f / ray.Direction.z };
+
+	std::array<uint32_t, MAX_DEPTH + 1> stack;
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	uint32_t intersectionCount = 0;
+	while (stackSize > 0)
+	{
+		const auto& node = m_Nodes[stack[--stackSize]];
+		if (!node.Bounds.IntersectsRay(ray.Origin, inverseDirection))
+			continue;
+
+		if (node.IsLeaf())
+		{
+			intersectionCount += m_TriangleRecords->CountRayIntersections(ray, node.FirstIndex, node.TriangleCount);
+		}
+		else
+		{
+			stack[stackSize++] = node.FirstIndex;
+			stack[stackSize++] = node.FirstIndex + 1;
+		}
+	}
+
+	return intersectionCount;
+}
+
+std::array<uint32_t, RAY_PACKET_SIZE> BVH::CountRayIntersections(const RayPacket& packet) const
+{
+	const auto& direction = packet.Direction;
+	const Vector3f inverseDirection = { 1.f / direction.x, 1.f / direction.y, 1.f / direction.z };
+
+	// Each entry remembers which rays reached the node, so a subtree is only tested against the rays that hit its parent
+	std::array<std::pair<uint32_t, uint32_t>, MAX_DEPTH + 1> stack;
+	uint32_t stackSize = 0;
+	stack[stackSize++] = { 0, packet.ActiveMask };
+
+	std::array<uint32_t, RAY_PACKET_SIZE> intersectionCounts = {};
+	while (stackSize > 0)
+	{
+		const auto [nodeIndex, parentMask] = stack[--stackSize];
+		const auto& node = m_Nodes[nodeIndex];
+
+		uint32_t activeMask = 0;
+		for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+		{
+			if (parentMask & (1u << lane))
+			{
+				const Vector3f origin = { packet.OriginX[lane], packet.OriginY[lane], packet.OriginZ[lane] };
+				if (node.Bounds.IntersectsRay(origin, inverseDirection))
+					activeMask |= 1u << lane;
+			}
+		}
+
+		if (activeMask == 0)
+			continue;
+
+		if (node.IsLeaf())
+		{
+			RayPacket activePacket = packet;
+			activePacket.ActiveMask = activeMask;
+
+			for (uint32_t i = node.FirstIndex; i < node.FirstIndex + node.TriangleCount; ++i)
+			{
+				const uint32_t hitMask = m_TriangleRecords->IntersectPacket(activePacket, i);
+				for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+					intersectionCounts[lane] += (hitMask >> lane) & 1;
+			}
+		}
+		else
+		{
+			stack[stackSize++] = { node.FirstIndex, activeMask };
+			stack[stackSize++] = { node.FirstIndex + 1, activeMask };
+		}
+	}
+
+	return intersectionCounts;
+}
+
+void BVH::GetRayIntersectionDistances(const Ray3f& ray, std::vector<float>& distances) const
+{
+	const Vector3f inverseDirection = { 1.f / ray.Direction.x, 1.f / ray.Direction.y, 1.f / ray.Direction.z };
+
+	std::array<uint32_t, MAX_DEPTH + 1> stack;
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	TriangleBlock::Lanes blockDistances;
+	while (stackSize > 0)
+	{
+		const auto& node = m_Nodes[stack[--stackSize]];
+		if (!node.Bounds.IntersectsRay(ray.Origin, inverseDirection))
+			continue;
+
+		if (node.IsLeaf())
+		{
+			const uint32_t lastIndex = node.FirstIndex + node.TriangleCount;
+			for (uint32_t blockIndex = node.FirstIndex / TRIANGLE_BLOCK_SIZE; blockIndex * TRIANGLE_BLOCK_SIZE < lastIndex; ++blockIndex)
+			{
+				const uint32_t hitMask = m_TriangleRecords->IntersectBlock(ray, blockIndex, blockDistances);
+				for (uint32_t lane = 0; lane < TRIANGLE_BLOCK_SIZE; ++lane)
+				{
+					const uint32_t index = blockIndex * TRIANGLE_BLOCK_SIZE + lane;
+					if ((hitMask & (1u << lane)) && node.FirstIndex <= index && index < lastIndex)
+						distances.push_back(blockDistances[lane]);
+				}
+			}
+		}
+		else
+		{
+			stack[stackSize++] = node.FirstIndex;
+			stack[stackSize++] = node.FirstIndex + 1;
+		}
+	}
+}
+
+BVH::SurfacePoint BVH::FindClosestPoint(const PositionBuffer& vertices, const TriangleBuffer& triangles, const Vector3f& point) const
+{
+	ASSERT(triangles.GetCount() == m_TriangleIndexes.size());
+
+	return vertices.Visit(
+		[&](const auto& typedVertices) -> SurfacePoint
+		{
+			return triangles.Visit(
+				[&](const auto& typedTriangles) -> SurfacePoint
+				{
+					std::array<uint32_t, MAX_DEPTH + 1> stack;
+					uint32_t stackSize = 0;
+					stack[stackSize++] = 0;
+
+					SurfacePoint closestPoint;
+					while (stackSize > 0)
+					{
+						const auto& node = m_Nodes[stack[--stackSize]];
+						if (node.Bounds.DistanceSquaredTo(point) >= closestPoint.DistanceSquared)
+							continue;
+
+						if (node.IsLeaf())
+						{
+							for (uint32_t i = node.FirstIndex; i < node.FirstIndex + node.TriangleCount; ++i)
+							{
+								const uint32_t triangleIndex = m_TriangleIndexes[i];
+								const auto& triangle = typedTriangles[triangleIndex];
+
+								const Vector3f vertex0 = typedVertices[triangle.VertexIndexes[0]];
+								const Vector3f vertex1 = typedVertices[triangle.VertexIndexes[1]];
+								const Vector3f vertex2 = typedVertices[triangle.VertexIndexes[2]];
+
+								const auto pointOnTriangle = ClosestPointOnTriangle(point, vertex0, vertex1, vertex2);
+								const float distanceSquared = (pointOnTriangle - point).MagnitudeSquared();
+								if (distanceSquared < closestPoint.DistanceSquared)
+									closestPoint = { pointOnTriangle, distanceSquared, triangleIndex };
+							}
+						}
+						else
+						{
+							// The nearer child is visited first, so the radius shrinks before the farther one is tested
+							const uint32_t leftIndex = node.FirstIndex;
+							const uint32_t rightIndex = node.FirstIndex + 1;
+							const bool isLeftNearer = m_Nodes[leftIndex].Bounds.DistanceSquaredTo(point) <= m_Nodes[rightIndex].Bounds.DistanceSquaredTo(point);
+
+							stack[stackSize++] = isLeftNearer ? rightIndex : leftIndex;
+							stack[stackSize++] = isLeftNearer ? leftIndex : rightIndex;
+						}
+					}
+
+					return closestPoint;
+				}
+			);
+		}
+	);
+}
\ No newline at end of file
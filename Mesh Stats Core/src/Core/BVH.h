@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Core/PositionBuffer.h"
+#include "Core/TriangleBuffer.h"
+#include "Core/TriangleRecords.h"
+#include "Math/AABB.h"
+#include "Math/Ray3.h"
+#include "Math/Vector3.h"
+
+// Bounding volume hierarchy over the triangles of a mesh
+// Built top-down with a binned surface area heuristic (SAH), big subtrees are built in parallel
+class BVH
+{
+public:
+	struct Node
+	{
+		AABBf Bounds;
+		uint32_t FirstIndex = 0; // Inner node: index of the left child (the right one follows it), leaf: index of the first triangle
+		uint32_t TriangleCount = 0; // 0 for inner nodes
+
+		bool IsLeaf() const;
+	};
+
+	struct SurfacePoint
+	{
+		Vector3f Point;
+		float DistanceSquared = std::numeric_limits<float>::max();
+		uint32_t TriangleIndex = 0; // Index in the mesh's triangles
+	};
+
+public:
+	BVH(const PositionBuffer& vertices, const TriangleBuffer& triangles);
+
+	const std::vector<BVH::Node>& GetNodes() const;
+	const std::vector<uint32_t>& GetTriangleIndexes() const;
+	const TriangleRecords& GetTriangleRecords() const;
+	uint32_t GetDepth() const;
+	double GetBuildTime() const;
+	size_t GetMemoryUsage() const; // Bytes, including the triangle records
+
+	// Counts every triangle hit by the ray, not only the closest one
+	uint32_t CountRayIntersections(const Ray3f& ray) const;
+	std::array<uint32_t, RAY_PACKET_SIZE> CountRayIntersections(const RayPacket& packet) const;
+
+	// Appends the distances along the ray of every hit, unsorted
+	void GetRayIntersectionDistances(const Ray3f& ray, std::vector<float>& distances) const;
+
+	// Closest point on the surface, the search radius shrinks with every closer triangle so most subtrees are skipped
+	// The triangles are read from the vertices and triangles the BVH was built over, rather than rebuilt from the records
+	// as vertex0 + edge, which would move the point off the surface by the rounding of the edges
+	BVH::SurfacePoint FindClosestPoint(const PositionBuffer& vertices, const TriangleBuffer& triangles, const Vector3f& point) const;
+
+private:
+	struct BuildData
+	{
+		std::vector<AABBf> TriangleBounds;
+		std::vector<Vector3f> TriangleCentroids;
+		std::atomic<uint32_t> NodeCount = 0;
+		std::atomic<uint32_t> Depth = 0;
+		uint32_t MaxParallelDepth = 0; // Deeper nodes build both children on the thread building them
+	};
+
+	void Build(const PositionBuffer& vertices, const TriangleBuffer& triangles);
+	void BuildNode(BVH::BuildData& buildData, const uint32_t nodeIndex, const uint32_t firstIndex, const uint32_t count, const uint32_t depth);
+
+private:
+	std::vector<BVH::Node> m_Nodes;
+	std::vector<uint32_t> m_TriangleIndexes;
+	std::optional<TriangleRecords> m_TriangleRecords; // In the order of m_TriangleIndexes
+	uint32_t m_Depth;
+	double m_BuildTime;
+};
\ No newline at end of file
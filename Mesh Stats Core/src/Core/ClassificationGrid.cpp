@@ -0,0 +1,231 @@
+#include "corepch.h"
+#include "Core/ClassificationGrid.h"
+
+#include "Utils/ThreadUtils.h"
+#include "Utils/TimeUtils.h"
+
+namespace
+{
+	constexpr uint32_t BITS_PER_CELL = 2;
+	constexpr uint32_t CELLS_PER_BYTE = 8 / BITS_PER_CELL;
+	constexpr uint8_t CELL_MASK = (1 << BITS_PER_CELL) - 1;
+
+	// Padding around the mesh bounds relative to their longest side, keeps the rows' ray origins outside the mesh
+	constexpr float BOUNDS_PADDING = 1e-3f;
+}
+
+ClassificationGrid::ClassificationGrid(const BVH& bvh, const uint32_t resolution)
+	: m_Resolution(std::max(resolution, 1u))
+	, m_CellSize(0.f)
+	, m_CellCounts{}
+	, m_CellStateCounts{}
+	, m_BuildTime(0.0)
+{
+	Build(bvh);
+}
+
+void ClassificationGrid::Build(const BVH& bvh)
+{
+	PROFILE_SCOPE("ClassificationGrid::Build");
+
+	const utils::Timer timer;
+
+	const auto& meshBounds = bvh.GetNodes().front().Bounds;
+	const auto meshExtent = meshBounds.GetExtent();
+	const float longestSide = std::max({ meshExtent.x, meshExtent.y, meshExtent.z, EPSILON });
+	const float padding = longestSide * BOUNDS_PADDING;
+
+	m_Bounds.Min = meshBounds.Min - Vector3f{ padding, padding, padding };
+	m_CellSize = (longestSide + 2.f * padding) / m_Resolution;
+
+	// Cells are cubes, so the shorter axes get fewer of them
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		m_CellCounts[axis] = std::max(1u, static_cast<uint32_t>(std::ceil((meshExtent[axis] + 2.f * padding) / m_CellSize)));
+		m_Bounds.Max[axis] = m_Bounds.Min[axis] + m_CellCounts[axis] * m_CellSize;
+	}
+
+	m_Cells.assign((GetCellCount() + CELLS_PER_BYTE - 1) / CELLS_PER_BYTE, 0);
+
+	MarkBoundaryCells(bvh);
+	ClassifyRows(bvh);
+	CountCellStates();
+
+	m_BuildTime = timer.GetElapsedMilliseconds();
+
+	LOG_INFO("Built {}x{}x{} classification grid: {} inside, {} outside, {} boundary cells, {} bytes, {} ms",
+		m_CellCounts[0], m_CellCounts[1], m_CellCounts[2],
+		GetCellCount(CellState::Inside), GetCellCount(CellState::Outside), GetCellCount(CellState::Boundary),
+		GetMemoryUsage(), m_BuildTime);
+}
+
+void ClassificationGrid::MarkBoundaryCells(const BVH& bvh)
+{
+	const auto& records = bvh.GetTriangleRecords();
+	const Vector3f cellHalfExtent = Vector3f{ m_CellSize, m_CellSize, m_CellSize } / 2.f;
+
+	utils::ParallelFor(records.GetTriangleCount(),
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			for (size_t i = startIndex; i < endIndex; ++i)
+			{
+				const uint32_t index = static_cast<uint32_t>(i);
+				const auto vertex0 = records.GetVertex0(index);
+				const auto edge1 = records.GetEdge1(index);
+				const auto edge2 = records.GetEdge2(index);
+				const auto normal = edge1.CrossProduct(edge2);
+
+				AABBf triangleBounds;
+				triangleBounds.Extend(vertex0);
+				triangleBounds.Extend(vertex0 + edge1);
+				triangleBounds.Extend(vertex0 + edge2);
+
+				std::array<uint32_t, 3> minCell, maxCell;
+				for (size_t axis = 0; axis < 3; ++axis)
+				{
+					const float inverseCellSize = 1.f / m_CellSize;
+					minCell[axis] = std::min(m_CellCounts[axis] - 1, static_cast<uint32_t>(std::max(0.f, (triangleBounds.Min[axis] - m_Bounds.Min[axis]) * inverseCellSize)));
+					maxCell[axis] = std::min(m_CellCounts[axis] - 1, static_cast<uint32_t>(std::max(0.f, (triangleBounds.Max[axis] - m_Bounds.Min[axis]) * inverseCellSize)));
+				}
+
+				// Conservative test: the cell overlaps the triangle's bounds and straddles its plane
+				const float planeReach = cellHalfExtent.x * std::abs(normal.x) + cellHalfExtent.y * std::abs(normal.y) + cellHalfExtent.z * std::abs(normal.z);
+				for (uint32_t z = minCell[2]; z <= maxCell[2]; ++z)
+				{
+					for (uint32_t y = minCell[1]; y <= maxCell[1]; ++y)
+					{
+						for (uint32_t x = minCell[0]; x <= maxCell[0]; ++x)
+						{
+							const Vector3f cellCenter = m_Bounds.Min + Vector3f{ x + 0.5f, y + 0.5f, z + 0.5f } * m_CellSize;
+							if (std::abs(normal.DotProduct(cellCenter - vertex0)) <= planeReach * (1.f + EPSILON))
+								SetCellStateAtomic(GetCellIndex(x, y, z), CellState::Boundary);
+						}
+					}
+				}
+			}
+		}
+	);
+}
+
+void ClassificationGrid::ClassifyRows(const BVH& bvh)
+{
+	static constexpr Vector3f ROW_DIRECTION = { 1.f, 0.f, 0.f };
+
+	const uint32_t rowCount = m_CellCounts[1] * m_CellCounts[2];
+
+	utils::ParallelFor(rowCount,
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			std::vector<float> distances;
+
+			for (size_t row = startIndex; row < endIndex; ++row)
+			{
+				const uint32_t y = static_cast<uint32_t>(row % m_CellCounts[1]);
+				const uint32_t z = static_cast<uint32_t>(row / m_CellCounts[1]);
+
+				// One ray through the cell centers of the whole row
+				const Vector3f origin = { m_Bounds.Min.x, m_Bounds.Min.y + (y + 0.5f) * m_CellSize, m_Bounds.Min.z + (z + 0.5f) * m_CellSize };
+				const Ray3f ray(origin, ROW_DIRECTION);
+
+				distances.clear();
+				bvh.GetRayIntersectionDistances(ray, distances);
+				std::sort(distances.begin(), distances.end());
+
+				// A row of a closed mesh crosses the surface an even number of times, an odd count means the ray grazed an edge or a vertex
+				// The parity along that row cannot be trusted, so its cells are left to the exact test
+				const bool isRowReliable = IsEven(distances.size());
+
+				size_t hitsBeforeCellCount = 0;
+				for (uint32_t x = 0; x < m_CellCounts[0]; ++x)
+				{
+					const size_t cellIndex = GetCellIndex(x, y, z);
+					if (GetCellState(cellIndex) == CellState::Boundary)
+						continue;
+
+					if (!isRowReliable)
+					{
+						SetCellStateAtomic(cellIndex, CellState::Boundary);
+						continue;
+					}
+
+					// Same parity as a ray cast from the cell center, like Mesh::IsPointInsideMesh does
+					const float cellCenterDistance = (x + 0.5f) * m_CellSize;
+					while (hitsBeforeCellCount < distances.size() && distances[hitsBeforeCellCount] < cellCenterDistance)
+						++hitsBeforeCellCount;
+
+					if (IsOdd(distances.size() - hitsBeforeCellCount))
+						SetCellStateAtomic(cellIndex, CellState::Inside);
+				}
+			}
+		}
+	);
+}
+
+void ClassificationGrid::CountCellStates()
+{
+	m_CellStateCounts = {};
+	for (size_t cellIndex = 0; cellIndex < GetCellCount(); ++cellIndex)
+		++m_CellStateCounts[static_cast<size_t>(GetCellState(cellIndex))];
+}
+
+uint32_t ClassificationGrid::GetResolution() const
+{
+	return m_Resolution;
+}
+
+const std::array<uint32_t, 3>& ClassificationGrid::GetCellCounts() const
+{
+	return m_CellCounts;
+}
+
+size_t ClassificationGrid::GetCellCount() const
+{
+	return static_cast<size_t>(m_CellCounts[0]) * m_CellCounts[1] * m_CellCounts[2];
+}
+
+size_t ClassificationGrid::GetCellCount(const ClassificationGrid::CellState state) const
+{
+	return m_CellStateCounts[static_cast<size_t>(state)];
+}
+
+size_t ClassificationGrid::GetMemoryUsage() const
+{
+	return sizeof(ClassificationGrid) + m_Cells.capacity() * sizeof(uint8_t);
+}
+
+double ClassificationGrid::GetBuildTime() const
+{
+	return m_BuildTime;
+}
+
+ClassificationGrid::CellState ClassificationGrid::GetCellState(const Vector3f& point) const
+{
+	if (!m_Bounds.Contains(point))
+		return CellState::Outside;
+
+	const float inverseCellSize = 1.f / m_CellSize;
+	const uint32_t x = std::min(m_CellCounts[0] - 1, static_cast<uint32_t>((point.x - m_Bounds.Min.x) * inverseCellSize));
+	const uint32_t y = std::min(m_CellCounts[1] - 1, static_cast<uint32_t>((point.y - m_Bounds.Min.y) * inverseCellSize));
+	const uint32_t z = std::min(m_CellCounts[2] - 1, static_cast<uint32_t>((point.z - m_Bounds.Min.z) * inverseCellSize));
+
+	return GetCellState(GetCellIndex(x, y, z));
+}
+
+size_t ClassificationGrid::GetCellIndex(const uint32_t x, const uint32_t y, const uint32_t z) const
+{
+	return x + static_cast<size_t>(m_CellCounts[0]) * (y + static_cast<size_t>(m_CellCounts[1]) * z);
+}
+
+ClassificationGrid::CellState ClassificationGrid::GetCellState(const size_t cellIndex) const
+{
+	// Atomic, because neighbouring cells sharing the byte may be written by other threads during the build
+	const uint8_t byte = std::atomic_ref<uint8_t>(const_cast<uint8_t&>(m_Cells[cellIndex / CELLS_PER_BYTE])).load(std::memory_order_relaxed);
+	return static_cast<CellState>((byte >> (cellIndex % CELLS_PER_BYTE * BITS_PER_CELL)) & CELL_MASK);
+}
+
+void ClassificationGrid::SetCellStateAtomic(const size_t cellIndex, const ClassificationGrid::CellState state)
+{
+	// States are only ever raised from Outside (0), so setting the bits is enough
+	const uint8_t bits = static_cast<uint8_t>(static_cast<uint8_t>(state) << (cellIndex % CELLS_PER_BYTE * BITS_PER_CELL));
+	std::atomic_ref<uint8_t>(m_Cells[cellIndex / CELLS_PER_BYTE]).fetch_or(bits, std::memory_order_relaxed);
+}
\ No newline at end of file
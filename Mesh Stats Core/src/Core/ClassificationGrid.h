@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Core/BVH.h"
+#include "Math/AABB.h"
+#include "Math/Vector3.h"
+
+// Voxel grid over the mesh bounds that classifies its cells as inside, outside or boundary (touched by triangles)
+// Points in inside or outside cells are classified in O(1), only the ones in boundary cells need an exact test
+class ClassificationGrid
+{
+public:
+	enum class CellState : uint8_t
+	{
+		Outside = 0,
+		Inside = 1,
+		Boundary = 2
+	};
+
+	static constexpr uint32_t DEFAULT_RESOLUTION = 128;
+
+public:
+	// The resolution is the number of cells along the longest axis of the mesh bounds
+	ClassificationGrid(const BVH& bvh, const uint32_t resolution);
+
+	uint32_t GetResolution() const;
+	const std::array<uint32_t, 3>& GetCellCounts() const;
+	size_t GetCellCount() const;
+	size_t GetCellCount(const ClassificationGrid::CellState state) const;
+	size_t GetMemoryUsage() const;
+	double GetBuildTime() const;
+
+	ClassificationGrid::CellState GetCellState(const Vector3f& point) const;
+
+private:
+	void Build(const BVH& bvh);
+	void MarkBoundaryCells(const BVH& bvh);
+	void ClassifyRows(const BVH& bvh);
+	void CountCellStates();
+
+	size_t GetCellIndex(const uint32_t x, const uint32_t y, const uint32_t z) const;
+	ClassificationGrid::CellState GetCellState(const size_t cellIndex) const;
+	void SetCellStateAtomic(const size_t cellIndex, const ClassificationGrid::CellState state);
+
+private:
+	uint32_t m_Resolution;
+	AABBf m_Bounds;
+	float m_CellSize;
+	std::array<uint32_t, 3> m_CellCounts;
+	std::vector<uint8_t> m_Cells; // 2 bits per cell
+	std::array<size_t, 3> m_CellStateCounts;
+	double m_BuildTime;
+};
\ No newline at end of file
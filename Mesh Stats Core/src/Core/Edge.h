@@ -0,0 +1,52 @@
+#pragma once
+
+template <typename Index>
+struct Edge
+{
+	std::pair<Index, Index> VertexIndexes;
+
+	Edge(const Index vertexIndex0, const Index vertexIndex1);
+
+	bool operator==(const Edge& other) const;
+	bool operator!=(const Edge& other) const;
+};
+
+template <typename Index>
+Edge<Index>::Edge(const Index vertexIndex0, const Index vertexIndex1)
+{
+	if (vertexIndex0 <= vertexIndex1)
+	{
+		VertexIndexes.first = vertexIndex0;
+		VertexIndexes.second = vertexIndex1;
+	}
+	else
+	{
+		VertexIndexes.first = vertexIndex1;
+		VertexIndexes.second = vertexIndex0;
+	}
+}
+
+template <typename Index>
+bool Edge<Index>::operator==(const Edge& other) const
+{
+	return VertexIndexes.first == other.VertexIndexes.first
+		&& VertexIndexes.second == other.VertexIndexes.second;
+}
+
+template <typename Index>
+bool Edge<Index>::operator!=(const Edge& other) const
+{
+	return !(*this == other);
+}
+
+namespace std
+{
+	template <typename Index>
+	struct hash<Edge<Index>>
+	{
+		size_t operator()(const Edge<Index>& edge) const
+		{
+			return hash<Index>()(edge.VertexIndexes.first) ^ (hash<Index>()(edge.VertexIndexes.second) << 1);
+		}
+	};
+}
\ No newline at end of file
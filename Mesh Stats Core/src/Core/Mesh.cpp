@@ -0,0 +1,1093 @@
+#include "corepch.h"
+#include "Core/Mesh.h"
+
+#include "Core/Edge.h"
+#include "Core/MeshFileReader.h"
+#include "Core/MeshReorder.h"
+#include "Math/AABB.h"
+#include "Math/Morton.h"
+#include "Math/Ray3.h"
+#include "Utils/FileUtils.h"
+#include "Utils/MemoryUtils.h"
+#include "Utils/ScratchArena.h"
+#include "Utils/ThreadUtils.h"
+
+namespace
+{
+	// Direction of the rays cast by the point inside mesh tests, can be any direction
+	constexpr Vector3f RAY_DIRECTION = { 1.f, 0.f, 0.f };
+
+	// The first estimate of the statistics samples 2 * 2^10 triangles, and each refinement four times as many, until
+	// more than 1 / 64 of the triangles would be, which would take about as long as computing the statistics on every core
+	constexpr size_t STATISTICS_SAMPLES_PER_STRATUM = 2;
+	constexpr size_t MIN_STATISTICS_STRATA_COUNT = 1 << 10;
+	constexpr size_t STATISTICS_STRATA_GROWTH = 4;
+	constexpr size_t MAX_SAMPLED_TRIANGLES_DIVISOR = 64;
+	constexpr uint32_t STATISTICS_RANDOM_SEED = 0; // The same estimates for the same mesh
+	constexpr double CONFIDENCE_Z_SCORE = 1.96; // Of a 95% two-sided confidence interval
+
+	bool IsInsideByWindingNumber(const float windingNumber)
+	{
+		// Inverted meshes have negative winding numbers
+		return std::abs(windingNumber) >= 0.5f;
+	}
+
+	std::vector<uint32_t> GetAllPointIndexes(const size_t pointCount)
+	{
+		std::vector<uint32_t> pointIndexes(pointCount);
+		std::iota(pointIndexes.begin(), pointIndexes.end(), 0u);
+		return pointIndexes;
+	}
+
+	void LogStatistics(const Mesh::Statistics& statistics)
+	{
+		LOG_INFO("Smallest triangle area: {}", statistics.SmallestTriangleArea);
+		LOG_INFO("Biggest triangle area: {}", statistics.BiggestTriangleArea);
+		LOG_INFO("Average triangle area: {}", statistics.AverageTriangleArea);
+	}
+
+	void LogEdges(const uint64_t edgeCount, const bool isClosed)
+	{
+		LOG_INFO("Edges: {}", edgeCount);
+		LOG_INFO("IsClosed: {}", isClosed ? "true" : "false");
+	}
+
+	// Queries close along a Morton curve visit mostly the same nodes, which keeps them in cache
+	void SortByMortonOrder(std::span<const Vector3f> points, std::vector<uint32_t>& pointIndexes)
+	{
+		AABBf bounds;
+		std::mutex boundsMtx;
+		utils::ParallelFor(pointIndexes.size(),
+			[&](const size_t startIndex, const size_t endIndex) -> void
+			{
+				AABBf chunkBounds;
+				for (size_t i = startIndex; i < endIndex; ++i)
+					chunkBounds.Extend(points[pointIndexes[i]]);
+
+				std::lock_guard lock(boundsMtx);
+				bounds.Extend(chunkBounds);
+			}
+		);
+
+		std::vector<std::pair<uint64_t, uint32_t>> mortonCodeToPointIndex(pointIndexes.size());
+		utils::ParallelFor(pointIndexes.size(),
+			[&](const size_t startIndex, const size_t endIndex) -> void
+			{
+				for (size_t i = startIndex; i < endIndex; ++i)
+					mortonCodeToPointIndex[i] = { EncodeMorton3(points[pointIndexes[i]], bounds), pointIndexes[i] };
+			}
+		);
+
+		utils::ParallelSort(std::span(mortonCodeToPointIndex));
+
+		for (size_t i = 0; i < pointIndexes.size(); ++i)
+			pointIndexes[i] = mortonCodeToPointIndex[i].second;
+	}
+}
+
+/*static*/ std::optional<Mesh> Mesh::LoadFromFile(const fs::path& filepath)
+{
+	return LoadFromFile(filepath, LoadOptions());
+}
+
+/*static*/ std::optional<Mesh> Mesh::LoadFromFile(const fs::path& filepath, const Mesh::LoadOptions& options)
+{
+	PROFILE_SCOPE("Mesh::LoadFromFile");
+
+	utils::AllocationScope allocationScope;
+
+	auto contents = MeshFileReader::Read(filepath);
+	if (!contents) return {};
+
+	if (options.ReorderForLocality)
+		MeshReorder::Reorder(contents->Vertices, contents->Triangles);
+
+	// Neither depends on the order of the vertices and triangles, but the areas were measured before any quantization
+	KnownAttributes knownAttributes;
+	knownAttributes.EdgeCountAndIsClosed = contents->EdgeCountAndIsClosed;
+	if (options.VertexEncoding == PositionBuffer::Encoding::Float)
+		knownAttributes.Statistics = contents->Statistics;
+
+	Mesh mesh(PositionBuffer(std::move(contents->Vertices), options.VertexEncoding), std::move(contents->Triangles), knownAttributes);
+
+	const auto allocations = allocationScope.Stop();
+	mesh.m_ConstructionMemory.LoadPeakBytes = allocations.PeakBytes;
+	mesh.m_ConstructionMemory.AllocationCount = allocations.AllocationCount;
+	mesh.m_ConstructionMemory.IsExclusive = allocations.IsExclusive;
+
+	return mesh;
+}
+
+/*static*/ bool Mesh::SaveToFile(const fs::path& filepath, const Mesh& mesh)
+{
+	json::Document jsonDocument;
+	auto& jsonAllocator = jsonDocument.GetAllocator();
+
+	json::Value jsonVertices(json::kArrayType);
+	mesh.m_Vertices.Visit(
+		[&](const auto& vertices) -> void
+		{
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				const Vector3f vertex = vertices[i];
+				jsonVertices.PushBack(vertex.x, jsonAllocator);
+				jsonVertices.PushBack(vertex.y, jsonAllocator);
+				jsonVertices.PushBack(vertex.z, jsonAllocator);
+			}
+		}
+	);
+
+	json::Value jsonTriangles(json::kArrayType);
+	mesh.m_Triangles->Visit(
+		[&](const auto& triangles) -> void
+		{
+			for (const auto& trianlge : triangles)
+			{
+				jsonTriangles.PushBack(static_cast<uint64_t>(trianlge.VertexIndexes[0]), jsonAllocator);
+				jsonTriangles.PushBack(static_cast<uint64_t>(trianlge.VertexIndexes[1]), jsonAllocator);
+				jsonTriangles.PushBack(static_cast<uint64_t>(trianlge.VertexIndexes[2]), jsonAllocator);
+			}
+		}
+	);
+
+	json::Value jsonGeometryObject(json::kObjectType);
+	jsonGeometryObject.AddMember("vertices", jsonVertices, jsonAllocator);
+	jsonGeometryObject.AddMember("triangles", jsonTriangles, jsonAllocator);
+
+	jsonDocument.SetObject();
+	jsonDocument.AddMember("geometry_object", jsonGeometryObject, jsonAllocator);
+
+	json::StringBuffer jsonStringBuffer;
+	json::Writer<json::StringBuffer> jsonWriter(jsonStringBuffer);
+	jsonDocument.Accept(jsonWriter);
+
+	return utils::WriteFile(filepath, jsonStringBuffer.GetString());
+}
+
+/*static*/ bool Mesh::SaveToObjFile(const fs::path& filepath, const Mesh& mesh)
+{
+	static constexpr size_t LINE_INITIAL_CAPACITY = 32;
+
+	std::string data;
+	data.reserve((mesh.m_Vertices.GetCount() + mesh.m_Triangles->GetCount()) * LINE_INITIAL_CAPACITY);
+
+	mesh.m_Vertices.Visit(
+		[&data](const auto& vertices) -> void
+		{
+			for (size_t i = 0; i < vertices.size(); ++i)
+			{
+				const Vector3f vertex = vertices[i];
+				std::format_to(std::back_inserter(data), "v {} {} {}\n", vertex.x, vertex.y, vertex.z);
+			}
+		}
+	);
+
+	// OBJ indexes start from 1
+	mesh.m_Triangles->Visit(
+		[&data](const auto& triangles) -> void
+		{
+			for (const auto& triangle : triangles)
+			{
+				std::format_to(std::back_inserter(data), "f {} {} {}\n", uint64_t(triangle.VertexIndexes[0]) + 1,
+					uint64_t(triangle.VertexIndexes[1]) + 1, uint64_t(triangle.VertexIndexes[2]) + 1);
+			}
+		}
+	);
+
+	return utils::WriteFile(filepath, data);
+}
+
+Mesh::Mesh(std::vector<Vector3f>&& vertices, TriangleBuffer&& triangles)
+	: Mesh(PositionBuffer(std::move(vertices)), std::move(triangles))
+{
+}
+
+Mesh::Mesh(PositionBuffer&& vertices, TriangleBuffer&& triangles)
+	: Mesh(std::move(vertices), std::move(triangles), KnownAttributes())
+{
+}
+
+Mesh::Mesh(PositionBuffer&& vertices, TriangleBuffer&& triangles, const Mesh::KnownAttributes& knownAttributes)
+	: m_Vertices(std::move(vertices))
+	, m_Triangles(std::make_shared<const TriangleBuffer>(std::move(triangles)))
+	, m_Cache(std::make_unique<Mesh::Cache>())
+{
+	ASSERT(m_Vertices.GetCount() > 0 && m_Triangles->GetCount() > 0);
+
+	AddAttributeTasks(knownAttributes);
+
+	LOG_INFO("Vertices: {} ({}, error up to {})", m_Vertices.GetCount(), PositionBuffer::GetEncodingName(m_Vertices.GetEncoding()), m_Vertices.GetMaxError());
+	LOG_INFO("Triangles: {} ({}-byte vertex indexes)", m_Triangles->GetCount(), m_Triangles->GetIndexSize());
+}
+
+void Mesh::AddAttributeTasks(const Mesh::KnownAttributes& knownAttributes)
+{
+	// The tasks only reach the mesh through these, so they do not depend on where the mesh is
+	auto* const cache = m_Cache.get();
+	auto& tasks = cache->Tasks;
+	auto& attributeTasks = cache->AttributeTasks;
+	const PositionBuffer vertices = m_Vertices;
+	const std::shared_ptr<const TriangleBuffer> triangles = m_Triangles;
+
+	const auto addAttributeTask = [&](const Attribute attribute, std::function<void()>&& function, const std::vector<utils::TaskGraph::TaskId>& dependencies = {}) -> void
+		{
+			attributeTasks[static_cast<size_t>(attribute)] = tasks.Add(std::move(function), dependencies);
+		};
+
+	// Released once every task reading them has run
+	const auto faceNormals = std::make_shared<std::vector<Vector3f>>();
+	const auto faceNormalsTask = tasks.Add(
+		[vertices, triangles, faceNormals]() -> void
+		{
+			*faceNormals = CalculateFaceNormals(vertices, *triangles);
+		}
+	);
+
+	addAttributeTask(Attribute::SmoothVertexNormals,
+		[vertices, triangles, faceNormals, cache]() -> void
+		{
+			const auto& smoothVertexNormals = cache->SmoothVertexNormals = CalculateSmoothVertexNormals(vertices, *triangles, *faceNormals);
+
+			LOG_INFO("Smooth vertex normals: {} ({}, error up to {} degrees)", smoothVertexNormals.GetCount(),
+				smoothVertexNormals.IsEncoded() ? "octahedral-encoded" : "32-bit floats", RadToDeg(smoothVertexNormals.GetMaxAngularError()));
+		},
+		{ faceNormalsTask }
+	);
+
+	if (knownAttributes.Statistics)
+	{
+		cache->Statistics = *knownAttributes.Statistics;
+		attributeTasks[static_cast<size_t>(Attribute::Statistics)] = tasks.AddDone();
+		LogStatistics(cache->Statistics);
+	}
+	else
+	{
+		addAttributeTask(Attribute::Statistics,
+			[faceNormals, cache]() -> void
+			{
+				cache->Statistics = CalculateStatistics(*faceNormals);
+				LogStatistics(cache->Statistics);
+			},
+			{ faceNormalsTask }
+		);
+
+		// Reads only the sampled triangles, so it does not wait for the face normals
+		cache->StatisticsEstimateTask = tasks.Add(
+			[vertices, triangles, cache, statisticsTask = attributeTasks[static_cast<size_t>(Attribute::Statistics)]]() -> void
+			{
+				std::mt19937 randomEngine(STATISTICS_RANDOM_SEED);
+
+				for (size_t strataCount = MIN_STATISTICS_STRATA_COUNT;
+					strataCount * STATISTICS_SAMPLES_PER_STRATUM * MAX_SAMPLED_TRIANGLES_DIVISOR <= triangles->GetCount();
+					strataCount *= STATISTICS_STRATA_GROWTH)
+				{
+					if (cache->Tasks.IsDone(statisticsTask))
+						return;
+
+					cache->StatisticsEstimate = std::make_shared<const StatisticsEstimate>(EstimateStatistics(vertices, *triangles, strataCount, randomEngine));
+				}
+			}
+		);
+	}
+
+	if (knownAttributes.EdgeCountAndIsClosed)
+	{
+		std::tie(cache->EdgeCount, cache->IsClosed) = *knownAttributes.EdgeCountAndIsClosed;
+		attributeTasks[static_cast<size_t>(Attribute::Edges)] = tasks.AddDone();
+		LogEdges(cache->EdgeCount, cache->IsClosed);
+	}
+	else
+	{
+		addAttributeTask(Attribute::Edges,
+			[vertexCount = vertices.GetCount(), triangles, cache]() -> void
+			{
+				std::tie(cache->EdgeCount, cache->IsClosed) = CalculateEdgeCountAndIsClosed(vertexCount, *triangles);
+				LogEdges(cache->EdgeCount, cache->IsClosed);
+			}
+		);
+	}
+
+	addAttributeTask(Attribute::BVH,
+		[vertices, triangles, cache]() -> void
+		{
+			cache->BoundingVolumeHierarchy = std::make_unique<BVH>(vertices, *triangles);
+		}
+	);
+
+	addAttributeTask(Attribute::TriangleRecords,
+		[vertices, triangles, cache]() -> void
+		{
+			cache->Records = std::make_unique<TriangleRecords>(vertices, *triangles);
+		}
+	);
+
+	addAttributeTask(Attribute::FastWindingNumber,
+		[cache]() -> void
+		{
+			cache->WindingNumber = std::make_unique<FastWindingNumber>(*cache->BoundingVolumeHierarchy);
+		},
+		{ attributeTasks[static_cast<size_t>(Attribute::BVH)] }
+	);
+}
+
+void Mesh::WaitFor(const Mesh::Attribute attribute) const
+{
+	m_Cache->Tasks.Wait(m_Cache->AttributeTasks[static_cast<size_t>(attribute)]);
+}
+
+/*static*/ std::vector<Vector3f> Mesh::CalculateFaceNormals(const PositionBuffer& vertices, const TriangleBuffer& triangles)
+{
+	PROFILE_SCOPE("Mesh::CalculateFaceNormals");
+
+	std::vector<Vector3f> faceNormals(triangles.GetCount());
+
+	vertices.Visit(
+		[&](const auto& typedVertices) -> void
+		{
+			triangles.Visit(
+				[&](const auto& typedTriangles) -> void
+				{
+					utils::ParallelFor(typedTriangles.size(),
+						[&](const size_t startIndex, const size_t endIndex) -> void
+						{
+							for (size_t i = startIndex; i < endIndex; ++i)
+							{
+								const auto& triangle = typedTriangles[i];
+
+								const Vector3f vertex0 = typedVertices[triangle.VertexIndexes[0]];
+								const Vector3f vertex1 = typedVertices[triangle.VertexIndexes[1]];
+								const Vector3f vertex2 = typedVertices[triangle.VertexIndexes[2]];
+
+								const auto edge1 = vertex1 - vertex0;
+								const auto edge2 = vertex2 - vertex0;
+								faceNormals[i] = edge1.CrossProduct(edge2);
+							}
+						}
+					);
+				}
+			);
+		}
+	);
+
+	return faceNormals;
+}
+
+/*static*/ NormalBuffer Mesh::CalculateSmoothVertexNormals(const PositionBuffer& vertices, const TriangleBuffer& triangles, std::span<const Vector3f> faceNormals)
+{
+	PROFILE_SCOPE("Mesh::CalculateSmoothVertexNormals");
+
+	// Summed as floats, then encoded if the vertices are quantized
+	std::vector<Vector3f> smoothVertexNormals(vertices.GetCount());
+
+	triangles.Visit(
+		[&](const auto& typedTriangles) -> void
+		{
+			for (size_t i = 0; i < typedTriangles.size(); ++i)
+			{
+				for (const auto vertexIndex : typedTriangles[i].VertexIndexes)
+					smoothVertexNormals[vertexIndex] += faceNormals[i];
+			}
+		}
+	);
+
+	for (auto& smoothVertexNormal : smoothVertexNormals)
+	{
+		if (smoothVertexNormal.MagnitudeSquared() > EPSILON)
+			smoothVertexNormal = smoothVertexNormal.Normalized();
+	}
+
+	return NormalBuffer(std::move(smoothVertexNormals), vertices.IsQuantized());
+}
+
+/*static*/ Mesh::Statistics Mesh::CalculateStatistics(std::span<const Vector3f> faceNormals)
+{
+	PROFILE_SCOPE("Mesh::CalculateStatistics");
+
+	ASSERT(!faceNormals.empty());
+
+	Statistics statistics;
+	double areaSum = 0.0;
+	std::mutex statisticsMtx;
+
+	// Each chunk keeps its own extremes and sum, which are merged once per chunk
+	utils::ParallelFor(faceNormals.size(),
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			Statistics chunkStatistics;
+			double chunkAreaSum = 0.0;
+
+			for (size_t i = startIndex; i < endIndex; ++i)
+			{
+				const float area = faceNormals[i].Magnitude() / 2.f;
+
+				if (area > EPSILON && (area < chunkStatistics.SmallestTriangleArea || chunkStatistics.SmallestTriangleArea == 0.f))
+					chunkStatistics.SmallestTriangleArea = area;
+
+				if (chunkStatistics.BiggestTriangleArea < area)
+					chunkStatistics.BiggestTriangleArea = area;
+
+				chunkAreaSum += area;
+			}
+
+			std::lock_guard lock(statisticsMtx);
+
+			if (chunkStatistics.SmallestTriangleArea > 0.f && (chunkStatistics.SmallestTriangleArea < statistics.SmallestTriangleArea || statistics.SmallestTriangleArea == 0.f))
+				statistics.SmallestTriangleArea = chunkStatistics.SmallestTriangleArea;
+
+			statistics.BiggestTriangleArea = std::max(statistics.BiggestTriangleArea, chunkStatistics.BiggestTriangleArea);
+			areaSum += chunkAreaSum;
+		}
+	);
+
+	statistics.AverageTriangleArea = static_cast<float>(areaSum / faceNormals.size());
+	return statistics;
+}
+
+/*static*/ Mesh::StatisticsEstimate Mesh::EstimateStatistics(const PositionBuffer& vertices, const TriangleBuffer& triangles, const size_t strataCount, std::mt19937& randomEngine)
+{
+	PROFILE_SCOPE("Mesh::EstimateStatistics");
+
+	const size_t triangleCount = triangles.GetCount();
+	ASSERT(strataCount > 0 && strataCount * STATISTICS_SAMPLES_PER_STRATUM <= triangleCount);
+
+	StatisticsEstimate estimate;
+	estimate.SampleCount = strataCount * STATISTICS_SAMPLES_PER_STRATUM;
+
+	auto& statistics = estimate.Statistics;
+	double average = 0.0;
+	double averageVariance = 0.0;
+
+	vertices.Visit(
+		[&](const auto& typedVertices) -> void
+		{
+			triangles.Visit(
+				[&](const auto& typedTriangles) -> void
+				{
+					const auto getArea = [&](const size_t triangleIndex) -> float
+						{
+							const auto& triangle = typedTriangles[triangleIndex];
+
+							const Vector3f vertex0 = typedVertices[triangle.VertexIndexes[0]];
+							const Vector3f vertex1 = typedVertices[triangle.VertexIndexes[1]];
+							const Vector3f vertex2 = typedVertices[triangle.VertexIndexes[2]];
+
+							return (vertex1 - vertex0).CrossProduct(vertex2 - vertex0).Magnitude() / 2.f;
+						};
+
+					for (size_t stratumIndex = 0; stratumIndex < strataCount; ++stratumIndex)
+					{
+						const size_t startIndex = triangleCount * stratumIndex / strataCount;
+						const size_t stratumSize = triangleCount * (stratumIndex + 1) / strataCount - startIndex;
+
+						// Two distinct triangles of the stratum, the second is drawn among the others
+						const size_t sampleIndex0 = std::uniform_int_distribution<size_t>(0, stratumSize - 1)(randomEngine);
+						size_t sampleIndex1 = std::uniform_int_distribution<size_t>(0, stratumSize - 2)(randomEngine);
+						if (sampleIndex1 >= sampleIndex0)
+							++sampleIndex1;
+
+						const std::array<float, STATISTICS_SAMPLES_PER_STRATUM> areas = { getArea(startIndex + sampleIndex0), getArea(startIndex + sampleIndex1) };
+
+						// Same rules as CalculateStatistics
+						for (const float area : areas)
+						{
+							if (area > EPSILON && (area < statistics.SmallestTriangleArea || statistics.SmallestTriangleArea == 0.f))
+								statistics.SmallestTriangleArea = area;
+
+							if (statistics.BiggestTriangleArea < area)
+								statistics.BiggestTriangleArea = area;
+						}
+
+						// Each stratum weighs as much as the share of the triangles it holds, and its sample variance is
+						// corrected for sampling without replacement, so that it vanishes once the whole stratum is sampled
+						const double weight = static_cast<double>(stratumSize) / triangleCount;
+						const double sampleVariance = std::pow(static_cast<double>(areas[0]) - areas[1], 2.0) / 2.0;
+						const double finitePopulationCorrection = 1.0 - static_cast<double>(STATISTICS_SAMPLES_PER_STRATUM) / stratumSize;
+
+						average += weight * (static_cast<double>(areas[0]) + areas[1]) / STATISTICS_SAMPLES_PER_STRATUM;
+						averageVariance += weight * weight * finitePopulationCorrection * sampleVariance / STATISTICS_SAMPLES_PER_STRATUM;
+					}
+				}
+			);
+		}
+	);
+
+	statistics.AverageTriangleArea = static_cast<float>(average);
+	estimate.AverageTriangleAreaMargin = static_cast<float>(CONFIDENCE_Z_SCORE * std::sqrt(averageVariance));
+	return estimate;
+}
+
+/*static*/ std::pair<uint64_t, bool> Mesh::CalculateEdgeCountAndIsClosed(const size_t vertexCount, const TriangleBuffer& triangles)
+{
+	PROFILE_SCOPE("Mesh::CalculateEdgeCountAndIsClosed");
+
+	return triangles.Visit(
+		[vertexCount](const auto& typedTriangles) -> std::pair<uint64_t, bool>
+		{
+			using Index = typename std::decay_t<decltype(typedTriangles)>::value_type::IndexType;
+
+			utils::ScratchArena scratchArena;
+
+			// Bucket estimate given using Euler's polyhedron formula: V - E + F = 2
+			std::pmr::unordered_map<Edge<Index>, uint32_t> edgeToNeighbourCount(vertexCount + typedTriangles.size() - 2, scratchArena.GetResource());
+
+			for (const auto& triangle : typedTriangles)
+			{
+				const Index vertexIndex0 = triangle.VertexIndexes[0];
+				const Index vertexIndex1 = triangle.VertexIndexes[1];
+				const Index vertexIndex2 = triangle.VertexIndexes[2];
+
+				const Edge<Index> edge0 = { vertexIndex0, vertexIndex1 };
+				const Edge<Index> edge1 = { vertexIndex1, vertexIndex2 };
+				const Edge<Index> edge2 = { vertexIndex2, vertexIndex0 };
+
+				++edgeToNeighbourCount[edge0];
+				++edgeToNeighbourCount[edge1];
+				++edgeToNeighbourCount[edge2];
+			}
+
+			const bool isClosed = std::all_of(edgeToNeighbourCount.begin(), edgeToNeighbourCount.end(),
+				[](const auto& edgeAndNeighbourCount) -> bool { return edgeAndNeighbourCount.second >= 2; });
+
+			return { edgeToNeighbourCount.size(), isClosed };
+		}
+	);
+}
+
+const PositionBuffer& Mesh::GetVertices() const
+{
+	return m_Vertices;
+}
+
+const TriangleBuffer& Mesh::GetTriangles() const
+{
+	return *m_Triangles;
+}
+
+const NormalBuffer& Mesh::GetSmoothVertexNormals() const
+{
+	WaitFor(Attribute::SmoothVertexNormals);
+	return m_Cache->SmoothVertexNormals;
+}
+
+const Mesh::Statistics& Mesh::GetStatistics() const
+{
+	WaitFor(Attribute::Statistics);
+	return m_Cache->Statistics;
+}
+
+std::optional<Mesh::StatisticsEstimate> Mesh::GetStatisticsEstimate() const
+{
+	if (IsReady(Attribute::Statistics))
+		return StatisticsEstimate{ m_Cache->Statistics, 0.f, m_Triangles->GetCount(), true };
+
+	static constexpr std::array<Attribute, 1> STATISTICS = { Attribute::Statistics };
+	Prefetch(STATISTICS);
+
+	if (const auto estimate = m_Cache->StatisticsEstimate.load())
+		return *estimate;
+
+	return {};
+}
+
+uint64_t Mesh::GetEdgeCount() const
+{
+	WaitFor(Attribute::Edges);
+	return m_Cache->EdgeCount;
+}
+
+bool Mesh::IsClosed() const
+{
+	WaitFor(Attribute::Edges);
+	return m_Cache->IsClosed;
+}
+
+const BVH& Mesh::GetBVH() const
+{
+	WaitFor(Attribute::BVH);
+	return *m_Cache->BoundingVolumeHierarchy;
+}
+
+const TriangleRecords& Mesh::GetTriangleRecords() const
+{
+	WaitFor(Attribute::TriangleRecords);
+	return *m_Cache->Records;
+}
+
+const FastWindingNumber& Mesh::GetFastWindingNumber() const
+{
+	WaitFor(Attribute::FastWindingNumber);
+	return *m_Cache->WindingNumber;
+}
+
+void Mesh::Prefetch() const
+{
+	Prefetch(ANALYSES);
+}
+
+void Mesh::Prefetch(std::span<const Mesh::Attribute> attributes) const
+{
+	for (const auto attribute : attributes)
+	{
+		m_Cache->Tasks.Start(m_Cache->AttributeTasks[static_cast<size_t>(attribute)]);
+
+		if (attribute == Attribute::Statistics && m_Cache->StatisticsEstimateTask)
+			m_Cache->Tasks.Start(*m_Cache->StatisticsEstimateTask);
+	}
+}
+
+std::shared_future<void> Mesh::GetFuture(const Mesh::Attribute attribute) const
+{
+	return m_Cache->Tasks.GetFuture(m_Cache->AttributeTasks[static_cast<size_t>(attribute)]);
+}
+
+bool Mesh::IsReady(const Mesh::Attribute attribute) const
+{
+	const auto task = m_Cache->AttributeTasks[static_cast<size_t>(attribute)];
+	return m_Cache->Tasks.IsDone(task) && !m_Cache->Tasks.IsFailed(task);
+}
+
+bool Mesh::IsFailed(const Mesh::Attribute attribute) const
+{
+	return m_Cache->Tasks.IsFailed(m_Cache->AttributeTasks[static_cast<size_t>(attribute)]);
+}
+
+bool Mesh::IsAnalyzed() const
+{
+	return std::ranges::all_of(ANALYSES,
+		[this](const Attribute attribute) -> bool
+		{
+			return m_Cache->Tasks.IsDone(m_Cache->AttributeTasks[static_cast<size_t>(attribute)]);
+		}
+	);
+}
+
+size_t Mesh::MemoryUsage::GetTotal() const
+{
+	return Vertices + Triangles + SmoothVertexNormals + BVH + TriangleRecords + FastWindingNumber + ClassificationGrid;
+}
+
+Mesh::MemoryUsage Mesh::GetMemoryUsage() const
+{
+	MemoryUsage memoryUsage;
+	memoryUsage.Vertices = m_Vertices.GetMemoryUsage();
+	memoryUsage.SharedVertices = m_Vertices.GetSharedMemoryUsage();
+	memoryUsage.Triangles = m_Triangles->GetMemoryUsage();
+
+	if (IsReady(Attribute::SmoothVertexNormals))
+		memoryUsage.SmoothVertexNormals = m_Cache->SmoothVertexNormals.GetMemoryUsage();
+
+	if (IsReady(Attribute::BVH))
+		memoryUsage.BVH = m_Cache->BoundingVolumeHierarchy->GetMemoryUsage();
+
+	if (IsReady(Attribute::TriangleRecords))
+		memoryUsage.TriangleRecords = m_Cache->Records->GetMemoryUsage();
+
+	if (IsReady(Attribute::FastWindingNumber))
+		memoryUsage.FastWindingNumber = m_Cache->WindingNumber->GetMemoryUsage();
+
+	if (const auto grid = GetClassificationGrid())
+		memoryUsage.ClassificationGrid = grid->GetMemoryUsage();
+
+	return memoryUsage;
+}
+
+const Mesh::ConstructionMemory& Mesh::GetConstructionMemory() const
+{
+	return m_ConstructionMemory;
+}
+
+std::shared_ptr<const ClassificationGrid> Mesh::BuildClassificationGrid(const uint32_t resolution) const
+{
+	auto grid = std::make_shared<const ClassificationGrid>(GetBVH(), resolution);
+	m_Cache->Grid.store(grid);
+
+	return grid;
+}
+
+void Mesh::ClearClassificationGrid() const
+{
+	m_Cache->Grid.store(nullptr);
+}
+
+std::shared_ptr<const ClassificationGrid> Mesh::GetClassificationGrid() const
+{
+	return m_Cache->Grid.load();
+}
+
+std::shared_ptr<const ClassificationGrid> Mesh::GetClassificationGridForQueries() const
+{
+	// The parity of rays through an open mesh is not constant within a cell, so there the grid would disagree with the exact test
+	return IsClosed() ? GetClassificationGrid() : nullptr;
+}
+
+Mesh Mesh::GenerateSubdividedMesh() const
+{
+	utils::JobProgress progress(SUBDIVISION_STAGE_COUNT);
+	return *GenerateSubdividedMesh(progress);
+}
+
+std::optional<Mesh> Mesh::GenerateSubdividedMesh(utils::JobProgress& progress) const
+{
+	PROFILE_SCOPE("Mesh::GenerateSubdividedMesh");
+
+	static constexpr size_t PROGRESS_UPDATE_INTERVAL = 1 << 16;
+
+	utils::AllocationScope allocationScope;
+
+	progress.BeginStage("Subdividing triangles");
+
+	// The subdivided mesh shares the vertices of this one, only the midpoints are new
+	const size_t vertexCount = m_Vertices.GetCount();
+	const uint64_t edgeCount = GetEdgeCount();
+	std::vector<Vector3f> midpoints;
+	midpoints.reserve(edgeCount);
+
+	// Every edge adds a midpoint, which may need wider vertex indexes than the current triangles
+	TriangleBuffer newTriangles(vertexCount + edgeCount);
+	newTriangles.Reserve(m_Triangles->GetCount() * 4);
+
+	const bool isCanceled = newTriangles.Visit(
+		[&](auto& typedNewTriangles) -> bool
+		{
+			using Index = typename std::decay_t<decltype(typedNewTriangles)>::value_type::IndexType;
+
+			utils::ScratchArena scratchArena;
+			std::pmr::unordered_map<Edge<Index>, Index> edgeToMidpointIndex(edgeCount, scratchArena.GetResource());
+
+			const auto getMidpointIndex = [&](const Edge<Index>& edge) -> Index
+				{
+					const auto it = edgeToMidpointIndex.find(edge);
+					if (it != edgeToMidpointIndex.end())
+						return it->second;
+
+					// Of the decoded vertices if quantized, the midpoints are then quantized on the same grid
+					auto midpoint = (m_Vertices.Get(edge.VertexIndexes.first) + m_Vertices.Get(edge.VertexIndexes.second)) / 2.f;
+					const Index midpointIndex = static_cast<Index>(vertexCount + midpoints.size());
+
+					midpoints.push_back(std::move(midpoint));
+					edgeToMidpointIndex[edge] = midpointIndex;
+
+					return midpointIndex;
+				};
+
+			return m_Triangles->Visit(
+				[&](const auto& triangles) -> bool
+				{
+					for (size_t i = 0; i < triangles.size(); ++i)
+					{
+						if (i % PROGRESS_UPDATE_INTERVAL == 0)
+						{
+							if (progress.IsCanceled()) return true;
+							progress.SetStageProgress(static_cast<float>(i) / triangles.size());
+						}
+
+						const auto& triangle = triangles[i];
+
+						const Index vertexIndex0 = static_cast<Index>(triangle.VertexIndexes[0]);
+						const Index vertexIndex1 = static_cast<Index>(triangle.VertexIndexes[1]);
+						const Index vertexIndex2 = static_cast<Index>(triangle.VertexIndexes[2]);
+
+						const Index midpointIndex0 = getMidpointIndex({ vertexIndex0, vertexIndex1 });
+						const Index midpointIndex1 = getMidpointIndex({ vertexIndex1, vertexIndex2 });
+						const Index midpointIndex2 = getMidpointIndex({ vertexIndex2, vertexIndex0 });
+
+						typedNewTriangles.emplace_back(vertexIndex0, midpointIndex0, midpointIndex2);
+						typedNewTriangles.emplace_back(vertexIndex1, midpointIndex1, midpointIndex0);
+						typedNewTriangles.emplace_back(vertexIndex2, midpointIndex2, midpointIndex1);
+						typedNewTriangles.emplace_back(midpointIndex0, midpointIndex1, midpointIndex2);
+					}
+
+					return false;
+				}
+			);
+		}
+	);
+
+	if (isCanceled) return {};
+
+	Mesh subdividedMesh(m_Vertices.Append(std::move(midpoints)), std::move(newTriangles));
+
+	const auto allocations = allocationScope.Stop();
+	subdividedMesh.m_ConstructionMemory.SubdivisionPeakBytes = allocations.PeakBytes;
+	subdividedMesh.m_ConstructionMemory.AllocationCount = allocations.AllocationCount;
+	subdividedMesh.m_ConstructionMemory.IsExclusive = allocations.IsExclusive;
+
+	return subdividedMesh;
+}
+
+// Single queries are not profiled, they run by the million in parallel loops and every scope takes the profiler's lock,
+// the batched queries are profiled as a whole instead
+bool Mesh::IsPointInsideMesh(const Vector3f& point) const
+{
+	if (const auto grid = GetClassificationGridForQueries())
+	{
+		const auto cellState = grid->GetCellState(point);
+		if (cellState != ClassificationGrid::CellState::Boundary)
+			return cellState == ClassificationGrid::CellState::Inside;
+	}
+
+	const Ray3f ray(point, RAY_DIRECTION);
+	return IsOdd(GetBVH().CountRayIntersections(ray));
+}
+
+bool Mesh::IsPointInsideMesh(const Vector3f& point, const Mesh::InsideTestOptions& options) const
+{
+	switch (options.Mode)
+	{
+	case InsideTestMode::RayParity:
+		return IsPointInsideMesh(point);
+	case InsideTestMode::WindingNumber:
+		return IsInsideByWindingNumber(GetWindingNumber(point, options.WindingNumberAccuracy));
+	}
+
+	return false;
+}
+
+bool Mesh::IsPointInsideMeshBruteForce(const Vector3f& point) const
+{
+	const Ray3f ray(point, RAY_DIRECTION);
+	return IsOdd(GetTriangleRecords().CountRayIntersections(ray));
+}
+
+utils::BitSet Mesh::ArePointsInsideMesh(std::span<const Vector3f> points, const Mesh::InsideTestOptions& options) const
+{
+	PROFILE_SCOPE("Mesh::ArePointsInsideMesh");
+
+	if (options.Mode == InsideTestMode::RayParity)
+		return ArePointsInsideMesh(points);
+
+	ASSERT(points.size() <= std::numeric_limits<uint32_t>::max());
+
+	utils::BitSet arePointsInside(points.size());
+	if (points.empty()) return arePointsInside;
+
+	auto mortonOrder = GetAllPointIndexes(points.size());
+	SortByMortonOrder(points, mortonOrder);
+	MarkPointsInsideMesh(points, mortonOrder, options, arePointsInside);
+
+	return arePointsInside;
+}
+
+utils::BitSet Mesh::ArePointsInsideMesh(std::span<const Vector3f> points) const
+{
+	PROFILE_SCOPE("Mesh::ArePointsInsideMesh::RayParity");
+
+	ASSERT(points.size() <= std::numeric_limits<uint32_t>::max());
+
+	utils::BitSet arePointsInside(points.size());
+	if (points.empty()) return arePointsInside;
+
+	// Points in cells away from the surface are answered by the grid, only the rest is traced
+	std::vector<uint32_t> mortonOrder;
+	if (const auto grid = GetClassificationGridForQueries())
+	{
+		std::mutex mortonOrderMtx;
+		utils::ParallelFor(points.size(),
+			[&](const size_t startIndex, const size_t endIndex) -> void
+			{
+				std::vector<uint32_t> chunkBoundaryPointIndexes;
+				for (size_t i = startIndex; i < endIndex; ++i)
+				{
+					switch (grid->GetCellState(points[i]))
+					{
+					case ClassificationGrid::CellState::Inside:
+						arePointsInside.SetAtomic(i);
+						break;
+					case ClassificationGrid::CellState::Boundary:
+						chunkBoundaryPointIndexes.push_back(static_cast<uint32_t>(i));
+						break;
+					case ClassificationGrid::CellState::Outside:
+						break;
+					}
+				}
+
+				// In any order, they are sorted next
+				std::lock_guard lock(mortonOrderMtx);
+				mortonOrder.insert(mortonOrder.end(), chunkBoundaryPointIndexes.begin(), chunkBoundaryPointIndexes.end());
+			}
+		);
+	}
+	else
+	{
+		mortonOrder = GetAllPointIndexes(points.size());
+	}
+
+	// The grid is looked up again for the boundary points, which costs little next to tracing them
+	SortByMortonOrder(points, mortonOrder);
+	MarkPointsInsideMesh(points, mortonOrder, InsideTestOptions(), arePointsInside);
+
+	return arePointsInside;
+}
+
+void Mesh::MarkPointsInsideMesh(std::span<const Vector3f> points, std::span<const uint32_t> queryOrder, const Mesh::InsideTestOptions& options, utils::BitSet& arePointsInside) const
+{
+	if (options.Mode == InsideTestMode::WindingNumber)
+	{
+		const auto& windingNumber = GetFastWindingNumber();
+		utils::ParallelFor(queryOrder.size(),
+			[&](const size_t startIndex, const size_t endIndex) -> void
+			{
+				for (size_t i = startIndex; i < endIndex; ++i)
+				{
+					const uint32_t pointIndex = queryOrder[i];
+					if (IsInsideByWindingNumber(windingNumber.Evaluate(points[pointIndex], options.WindingNumberAccuracy)))
+						arePointsInside.SetAtomic(pointIndex);
+				}
+			}
+		);
+
+		return;
+	}
+
+	const auto& bvh = GetBVH();
+	const auto grid = GetClassificationGridForQueries();
+
+	// Points in cells away from the surface are answered by the grid, the others are traced together as packets of
+	// consecutive queries
+	utils::ParallelFor(queryOrder.size(),
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			RayPacket packet;
+			packet.Direction = RAY_DIRECTION;
+			std::array<uint32_t, RAY_PACKET_SIZE> packetPointIndexes = {};
+			uint32_t packetPointCount = 0;
+
+			const auto tracePacket = [&]() -> void
+				{
+					const auto intersectionCounts = bvh.CountRayIntersections(packet);
+					for (uint32_t lane = 0; lane < packetPointCount; ++lane)
+					{
+						if (IsOdd(intersectionCounts[lane]))
+							arePointsInside.SetAtomic(packetPointIndexes[lane]);
+					}
+
+					packet.ActiveMask = 0;
+					packetPointCount = 0;
+				};
+
+			for (size_t i = startIndex; i < endIndex; ++i)
+			{
+				const uint32_t pointIndex = queryOrder[i];
+				const auto& point = points[pointIndex];
+
+				if (grid)
+				{
+					const auto cellState = grid->GetCellState(point);
+					if (cellState == ClassificationGrid::CellState::Inside)
+						arePointsInside.SetAtomic(pointIndex);
+
+					if (cellState != ClassificationGrid::CellState::Boundary)
+						continue;
+				}
+
+				const uint32_t lane = packetPointCount++;
+				packet.OriginX[lane] = point.x;
+				packet.OriginY[lane] = point.y;
+				packet.OriginZ[lane] = point.z;
+				packet.ActiveMask |= 1u << lane;
+				packetPointIndexes[lane] = pointIndex;
+
+				if (packetPointCount == RAY_PACKET_SIZE)
+					tracePacket();
+			}
+
+			if (packetPointCount > 0)
+				tracePacket();
+		}
+	);
+}
+
+float Mesh::GetWindingNumber(const Vector3f& point, const float accuracy /* = FastWindingNumber::DEFAULT_ACCURACY */) const
+{
+	return GetFastWindingNumber().Evaluate(point, accuracy);
+}
+
+Vector3f Mesh::ClosestPoint(const Vector3f& point) const
+{
+	return GetBVH().FindClosestPoint(m_Vertices, *m_Triangles, point).Point;
+}
+
+float Mesh::SignedDistance(const Vector3f& point) const
+{
+	return SignedDistance(point, InsideTestOptions());
+}
+
+float Mesh::SignedDistance(const Vector3f& point, const Mesh::InsideTestOptions& options) const
+{
+	const float distance = std::sqrt(GetBVH().FindClosestPoint(m_Vertices, *m_Triangles, point).DistanceSquared);
+	return IsPointInsideMesh(point, options) ? -distance : distance;
+}
+
+std::vector<Vector3f> Mesh::ClosestPoints(std::span<const Vector3f> points) const
+{
+	std::vector<Vector3f> closestPoints(points.size());
+	ClosestPoints(points, closestPoints);
+	return closestPoints;
+}
+
+void Mesh::ClosestPoints(std::span<const Vector3f> points, std::span<Vector3f> closestPoints) const
+{
+	PROFILE_SCOPE("Mesh::ClosestPoints");
+
+	ASSERT(points.size() <= std::numeric_limits<uint32_t>::max());
+	ASSERT(closestPoints.size() == points.size());
+
+	if (points.empty()) return;
+
+	const auto& bvh = GetBVH();
+	auto mortonOrder = GetAllPointIndexes(points.size());
+	SortByMortonOrder(points, mortonOrder);
+
+	utils::ParallelFor(points.size(),
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			for (size_t i = startIndex; i < endIndex; ++i)
+			{
+				const uint32_t pointIndex = mortonOrder[i];
+				closestPoints[pointIndex] = bvh.FindClosestPoint(m_Vertices, *m_Triangles, points[pointIndex]).Point;
+			}
+		}
+	);
+}
+
+std::vector<float> Mesh::SignedDistances(std::span<const Vector3f> points) const
+{
+	return SignedDistances(points, InsideTestOptions());
+}
+
+std::vector<float> Mesh::SignedDistances(std::span<const Vector3f> points, const Mesh::InsideTestOptions& options) const
+{
+	std::vector<float> signedDistances(points.size());
+	SignedDistances(points, options, signedDistances);
+	return signedDistances;
+}
+
+void Mesh::SignedDistances(std::span<const Vector3f> points, const Mesh::InsideTestOptions& options, std::span<float> signedDistances) const
+{
+	PROFILE_SCOPE("Mesh::SignedDistances");
+
+	ASSERT(points.size() <= std::numeric_limits<uint32_t>::max());
+	ASSERT(signedDistances.size() == points.size());
+
+	if (points.empty()) return;
+
+	const auto& bvh = GetBVH();
+	auto mortonOrder = GetAllPointIndexes(points.size());
+	SortByMortonOrder(points, mortonOrder);
+
+	// Sorted once for both the inside tests and the closest points
+	utils::BitSet arePointsInside(points.size());
+	MarkPointsInsideMesh(points, mortonOrder, options, arePointsInside);
+
+	utils::ParallelFor(points.size(),
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			for (size_t i = startIndex; i < endIndex; ++i)
+			{
+				const uint32_t pointIndex = mortonOrder[i];
+				const float distance = std::sqrt(bvh.FindClosestPoint(m_Vertices, *m_Triangles, points[pointIndex]).DistanceSquared);
+				signedDistances[pointIndex] = arePointsInside[pointIndex] ? -distance : distance;
+			}
+		}
+	);
+}
\ No newline at end of file
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "Core/BVH.h"
+#include "Core/ClassificationGrid.h"
+#include "Core/NormalBuffer.h"
+#include "Core/PositionBuffer.h"
+#include "Core/TriangleBuffer.h"
+#include "Core/TriangleRecords.h"
+#include "Core/WindingNumber.h"
+#include "Math/Vector3.h"
+#include "Utils/BitSet.h"
+#include "Utils/JobProgress.h"
+#include "Utils/TaskGraph.h"
+
+// Immutable once constructed: the derived attributes are computed once, on first use, and cached thread-safely,
+// so a mesh published as std::shared_ptr<const Mesh> can be read by any number of threads without locks
+class Mesh
+{
+public:
+	enum class InsideTestMode : uint8_t
+	{
+		RayParity, // Parity of the hits of a single ray, exact for closed meshes
+		WindingNumber // Generalized winding number, robust for open meshes and rays grazing edges or vertices
+	};
+
+	// Derived from the vertices and triangles on first access and cached, or ahead of it by Prefetch
+	enum class Attribute : uint8_t
+	{
+		SmoothVertexNormals,
+		Statistics,
+		Edges, // The edge count and whether the mesh is closed
+		BVH,
+		TriangleRecords,
+		FastWindingNumber
+	};
+
+	static constexpr size_t ATTRIBUTE_COUNT = 6;
+
+	// The attributes describing the mesh, as opposed to the structures accelerating its queries
+	static constexpr std::array<Mesh::Attribute, 3> ANALYSES = { Attribute::SmoothVertexNormals, Attribute::Statistics, Attribute::Edges };
+
+	struct InsideTestOptions
+	{
+		Mesh::InsideTestMode Mode = Mesh::InsideTestMode::RayParity;
+		float WindingNumberAccuracy = FastWindingNumber::DEFAULT_ACCURACY;
+	};
+
+	struct Statistics
+	{
+		float SmallestTriangleArea = 0.f;
+		float BiggestTriangleArea = 0.f;
+		float AverageTriangleArea = 0.f;
+	};
+
+	// Of stratified random samples of the triangles, until the statistics are computed
+	struct StatisticsEstimate
+	{
+		// The sampled extremes bound the exact ones: the smallest area is at most, and the biggest at least, what they are
+		Mesh::Statistics Statistics;
+		float AverageTriangleAreaMargin = 0.f; // Half the width of the 95% confidence interval around the average
+		uint64_t SampleCount = 0;
+		bool IsExact = false; // The statistics themselves, once they are computed
+	};
+
+	// Bytes held by the mesh, the caches count only once they are built
+	struct MemoryUsage
+	{
+		size_t Vertices = 0;
+		size_t SharedVertices = 0; // Part of the vertices also held by other meshes, like the one this one subdivides
+		size_t Triangles = 0;
+		size_t SmoothVertexNormals = 0;
+		size_t BVH = 0;
+		size_t TriangleRecords = 0;
+		size_t FastWindingNumber = 0;
+		size_t ClassificationGrid = 0;
+
+		size_t GetTotal() const;
+	};
+
+	// Heap allocations made while the mesh was created, on top of what it keeps, see utils::AllocationScope
+	struct ConstructionMemory
+	{
+		size_t LoadPeakBytes = 0; // The whole load, including the blocks queued between the stages of MeshFileReader
+		size_t SubdivisionPeakBytes = 0; // The whole subdivision that created the mesh
+		uint64_t AllocationCount = 0; // Of the whole load or subdivision
+		bool IsExclusive = false; // See utils::AllocationScope::Result, the numbers include another operation's allocations otherwise
+	};
+
+	struct LoadOptions
+	{
+		bool ReorderForLocality = false; // See MeshReorder, the vertex and triangle indexes then differ from the file's
+		PositionBuffer::Encoding VertexEncoding = PositionBuffer::Encoding::Float; // Quantized vertices also get octahedral-encoded normals
+	};
+
+public:
+	static std::optional<Mesh> LoadFromFile(const fs::path& filepath);
+	static std::optional<Mesh> LoadFromFile(const fs::path& filepath, const Mesh::LoadOptions& options);
+	static bool SaveToFile(const fs::path& filepath, const Mesh& mesh);
+	static bool SaveToObjFile(const fs::path& filepath, const Mesh& mesh);
+
+public:
+	// The triangles are stored with the narrowest vertex indexes for the vertex count, see TriangleBuffer
+	// The smooth vertex normals are octahedral-encoded if the vertices are quantized, see PositionBuffer and NormalBuffer
+	// Compute none of the attributes
+	template <typename Index>
+	Mesh(const std::vector<Vector3f>& vertices, const std::vector<Triangle<Index>>& triangles);
+	template <typename Index>
+	Mesh(std::vector<Vector3f>&& vertices, std::vector<Triangle<Index>>&& triangles);
+	Mesh(std::vector<Vector3f>&& vertices, TriangleBuffer&& triangles);
+	Mesh(PositionBuffer&& vertices, TriangleBuffer&& triangles);
+
+	const PositionBuffer& GetVertices() const;
+	const TriangleBuffer& GetTriangles() const;
+
+	// Compute the attribute they read unless it already is, then wait for it
+	const NormalBuffer& GetSmoothVertexNormals() const;
+	const Mesh::Statistics& GetStatistics() const;
+	uint64_t GetEdgeCount() const;
+	bool IsClosed() const;
+	const BVH& GetBVH() const;
+	const TriangleRecords& GetTriangleRecords() const;
+	const FastWindingNumber& GetFastWindingNumber() const;
+
+	// Does not wait, prefetches the statistics and meanwhile estimates them from samples growing in the background
+	// Empty until the first sample is estimated, which takes milliseconds whatever the size of the mesh
+	// Only meshes of 131072 triangles or more are sampled, smaller ones stay empty until their exact statistics are ready,
+	// and meshes loaded from a file with float vertices return the exact statistics measured while loading right away
+	std::optional<Mesh::StatisticsEstimate> GetStatisticsEstimate() const;
+
+	// Start computing the attributes concurrently in the background, without waiting, unless they already are
+	// Prefetching the statistics also starts estimating them, see GetStatisticsEstimate
+	void Prefetch() const; // The analyses
+	void Prefetch(std::span<const Mesh::Attribute> attributes) const;
+
+	// Ready once the attribute is computed, which the future starts, so it can be displayed without waiting for the others
+	// If the computation throws, the attribute is failed instead of ready and its getter rethrows the exception
+	std::shared_future<void> GetFuture(const Mesh::Attribute attribute) const;
+	bool IsReady(const Mesh::Attribute attribute) const;
+	bool IsFailed(const Mesh::Attribute attribute) const;
+	bool IsAnalyzed() const; // Every analysis is done, ready or failed
+
+	Mesh::MemoryUsage GetMemoryUsage() const; // The attributes count once they are computed
+	const Mesh::ConstructionMemory& GetConstructionMemory() const;
+
+	// Optional and built on request, speeds up the ray parity tests of points away from the surface of closed meshes
+	std::shared_ptr<const ClassificationGrid> BuildClassificationGrid(const uint32_t resolution) const;
+	void ClearClassificationGrid() const;
+	std::shared_ptr<const ClassificationGrid> GetClassificationGrid() const;
+
+	// Stages: subdividing the triangles, the new mesh is analyzed once it is read
+	static constexpr uint32_t SUBDIVISION_STAGE_COUNT = 1;
+
+	// The subdivided mesh shares the vertices of this one and only allocates the midpoints of the edges
+	Mesh GenerateSubdividedMesh() const;
+	std::optional<Mesh> GenerateSubdividedMesh(utils::JobProgress& progress) const; // Empty if canceled
+
+	bool IsPointInsideMesh(const Vector3f& point) const;
+	bool IsPointInsideMesh(const Vector3f& point, const Mesh::InsideTestOptions& options) const;
+	bool IsPointInsideMeshBruteForce(const Vector3f& point) const;
+
+	// Bit i is set if points[i] is inside the mesh, the queries are spread across all cores
+	utils::BitSet ArePointsInsideMesh(std::span<const Vector3f> points) const;
+	utils::BitSet ArePointsInsideMesh(std::span<const Vector3f> points, const Mesh::InsideTestOptions& options) const;
+
+	float GetWindingNumber(const Vector3f& point, const float accuracy = FastWindingNumber::DEFAULT_ACCURACY) const;
+
+	Vector3f ClosestPoint(const Vector3f& point) const;
+
+	// Distance to the surface, negative inside the mesh
+	float SignedDistance(const Vector3f& point) const;
+	float SignedDistance(const Vector3f& point, const Mesh::InsideTestOptions& options) const;
+
+	// Batched variants, the queries are spread across all cores
+	std::vector<Vector3f> ClosestPoints(std::span<const Vector3f> points) const;
+	std::vector<float> SignedDistances(std::span<const Vector3f> points) const;
+	std::vector<float> SignedDistances(std::span<const Vector3f> points, const Mesh::InsideTestOptions& options) const;
+
+	// Write into caller-owned buffers, which have to hold one element per point
+	void ClosestPoints(std::span<const Vector3f> points, std::span<Vector3f> closestPoints) const;
+	void SignedDistances(std::span<const Vector3f> points, const Mesh::InsideTestOptions& options, std::span<float> signedDistances) const;
+
+private:
+	// Computed while loading, see MeshFileReader, so they are ready as soon as the mesh is created
+	struct KnownAttributes
+	{
+		std::optional<Mesh::Statistics> Statistics;
+		std::optional<std::pair<uint64_t, bool>> EdgeCountAndIsClosed;
+	};
+
+	Mesh(PositionBuffer&& vertices, TriangleBuffer&& triangles, const Mesh::KnownAttributes& knownAttributes);
+
+	// Face normals are a dependency shared by the smooth vertex normals and the statistics, the other attributes need neither
+	void AddAttributeTasks(const Mesh::KnownAttributes& knownAttributes);
+	void WaitFor(const Mesh::Attribute attribute) const; // Rethrows, so the getters never read the data of a failed task
+
+	// Not normalized, their length is twice the area of their triangle
+	static std::vector<Vector3f> CalculateFaceNormals(const PositionBuffer& vertices, const TriangleBuffer& triangles);
+	static NormalBuffer CalculateSmoothVertexNormals(const PositionBuffer& vertices, const TriangleBuffer& triangles, std::span<const Vector3f> faceNormals);
+	static Mesh::Statistics CalculateStatistics(std::span<const Vector3f> faceNormals);
+	// Samples two triangles of each of the strata, equal ranges of triangle indexes, so that the samples cover the whole
+	// mesh and the spread within the strata gives the confidence interval
+	static Mesh::StatisticsEstimate EstimateStatistics(const PositionBuffer& vertices, const TriangleBuffer& triangles, const size_t strataCount, std::mt19937& randomEngine);
+	static std::pair<uint64_t, bool> CalculateEdgeCountAndIsClosed(const size_t vertexCount, const TriangleBuffer& triangles);
+
+	std::shared_ptr<const ClassificationGrid> GetClassificationGridForQueries() const;
+
+	// Sets the bits of the queried points that are inside the mesh, which are tested in the given order, so that batches
+	// already sorted along a Morton curve are not sorted again
+	void MarkPointsInsideMesh(std::span<const Vector3f> points, std::span<const uint32_t> queryOrder, const Mesh::InsideTestOptions& options, utils::BitSet& arePointsInside) const;
+
+private:
+	// Lazily computed data, written once by the task of each attribute and kept behind a pointer so that the mesh can be
+	// moved while the tasks run
+	struct Cache
+	{
+		NormalBuffer SmoothVertexNormals;
+		Mesh::Statistics Statistics;
+		uint64_t EdgeCount = 0;
+		bool IsClosed = false;
+		std::unique_ptr<BVH> BoundingVolumeHierarchy;
+		std::unique_ptr<TriangleRecords> Records;
+		std::unique_ptr<FastWindingNumber> WindingNumber;
+
+		std::atomic<std::shared_ptr<const ClassificationGrid>> Grid;
+		std::atomic<std::shared_ptr<const Mesh::StatisticsEstimate>> StatisticsEstimate; // The latest, replaced as the samples grow
+
+		std::array<utils::TaskGraph::TaskId, Mesh::ATTRIBUTE_COUNT> AttributeTasks = {}; // In the order of Mesh::Attribute
+		std::optional<utils::TaskGraph::TaskId> StatisticsEstimateTask; // Empty if the statistics were known
+
+		// Declared last, so that it is destroyed first and waits for the tasks writing the data above
+		utils::TaskGraph Tasks;
+	};
+
+private:
+	// The attribute tasks hold their own references to the vertices and triangles, which outlive a move of the mesh
+	PositionBuffer m_Vertices;
+	std::shared_ptr<const TriangleBuffer> m_Triangles;
+
+	Mesh::ConstructionMemory m_ConstructionMemory;
+
+	std::unique_ptr<Mesh::Cache> m_Cache;
+};
+
+template <typename Index>
+Mesh::Mesh(const std::vector<Vector3f>& vertices, const std::vector<Triangle<Index>>& triangles)
+	: Mesh(std::vector<Vector3f>(vertices), std::vector<Triangle<Index>>(triangles))
+{
+}
+
+template <typename Index>
+Mesh::Mesh(std::vector<Vector3f>&& vertices, std::vector<Triangle<Index>>&& triangles)
+	: Mesh(std::move(vertices), TriangleBuffer(std::move(triangles), vertices.size()))
+{
+}
\ No newline at end of file
@@ -0,0 +1,521 @@
+#include "corepch.h"
+#include "Core/MeshFileReader.h"
+
+#include "Utils/BoundedQueue.h"
+#include "Utils/ThreadUtils.h"
+
+#include "rapidjson/reader.h"
+
+namespace
+{
+	constexpr size_t READ_BLOCK_SIZE = 1 << 20; // Bytes
+	constexpr size_t TRIANGLE_BLOCK_SIZE = 1 << 14; // Triangles
+
+	// Blocks waiting between two stages, which bounds the memory of a stage running ahead of the next one
+	constexpr size_t QUEUE_CAPACITY = 8;
+
+	// Nesting levels of the members of the root object and of the geometry object
+	constexpr uint32_t ROOT_OBJECT_DEPTH = 1;
+	constexpr uint32_t GEOMETRY_OBJECT_DEPTH = 2;
+
+	using ReadBlock = std::vector<char>;
+	using VertexIndexBlock = std::vector<uint64_t>; // Three vertex indexes per triangle, lower than the vertex count
+
+	// End their side of a queue when they go out of scope, exceptions included, so the stage on the other side never waits
+	// forever for a stage that is gone
+	template<typename T>
+	class CloseOnExit
+	{
+	public:
+		explicit CloseOnExit(utils::BoundedQueue<T>& queue)
+			: m_Queue(queue)
+		{
+		}
+
+		~CloseOnExit()
+		{
+			m_Queue.Close();
+		}
+
+		CloseOnExit(const CloseOnExit&) = delete;
+		CloseOnExit& operator=(const CloseOnExit&) = delete;
+
+	private:
+		utils::BoundedQueue<T>& m_Queue;
+	};
+
+	template<typename T>
+	class CancelOnExit
+	{
+	public:
+		explicit CancelOnExit(utils::BoundedQueue<T>& queue)
+			: m_Queue(queue)
+		{
+		}
+
+		~CancelOnExit()
+		{
+			m_Queue.Cancel();
+		}
+
+		CancelOnExit(const CancelOnExit&) = delete;
+		CancelOnExit& operator=(const CancelOnExit&) = delete;
+
+	private:
+		utils::BoundedQueue<T>& m_Queue;
+	};
+
+	void ReadBlocks(std::ifstream& file, utils::BoundedQueue<ReadBlock>& readBlocks)
+	{
+		PROFILE_SCOPE("MeshFileReader::ReadBlocks");
+
+		const CloseOnExit closeReadBlocks(readBlocks);
+		for (;;)
+		{
+			ReadBlock block(READ_BLOCK_SIZE);
+			file.read(block.data(), block.size());
+			block.resize(static_cast<size_t>(file.gcount()));
+
+			// Stops early if the parser canceled, when the file has an invalid format
+			if (block.empty() || !readBlocks.Push(std::move(block))) break;
+		}
+	}
+
+	// RapidJSON input stream over the blocks of the reading thread, which waits for the next block once one is parsed
+	class BlockStream
+	{
+	public:
+		using Ch = char;
+
+	public:
+		explicit BlockStream(utils::BoundedQueue<ReadBlock>& readBlocks)
+			: m_ReadBlocks(readBlocks)
+		{
+			NextBlock();
+		}
+
+		Ch Peek() const
+		{
+			return m_Position < m_Block.size() ? m_Block[m_Position] : '\0';
+		}
+
+		Ch Take()
+		{
+			if (m_Position >= m_Block.size()) return '\0';
+
+			const Ch character = m_Block[m_Position++];
+			if (m_Position == m_Block.size())
+				NextBlock();
+
+			return character;
+		}
+
+		size_t Tell() const
+		{
+			return m_BlockOffset + m_Position;
+		}
+
+		// Only used by in situ parsing
+		Ch* PutBegin() { ASSERT(false); return nullptr; }
+		void Put(const Ch) { ASSERT(false); }
+		void Flush() { ASSERT(false); }
+		size_t PutEnd(Ch* const) { ASSERT(false); return 0; }
+
+	private:
+		void NextBlock()
+		{
+			m_BlockOffset += m_Block.size();
+			m_Position = 0;
+
+			auto block = m_ReadBlocks.Pop();
+			m_Block = block ? std::move(*block) : ReadBlock();
+		}
+
+	private:
+		utils::BoundedQueue<ReadBlock>& m_ReadBlocks;
+		ReadBlock m_Block;
+		size_t m_Position = 0;
+		size_t m_BlockOffset = 0;
+	};
+
+	// Builds the vertices and hands the triangles to the analysis in blocks, returning false on what the format does not allow,
+	// which stops the RapidJSON reader with an error
+	class MeshJsonHandler : public json::BaseReaderHandler<json::UTF8<>, MeshJsonHandler>
+	{
+	public:
+		MeshJsonHandler(std::vector<Vector3f>& vertices, utils::BoundedQueue<VertexIndexBlock>& vertexIndexBlocks)
+			: m_Vertices(vertices)
+			, m_VertexIndexBlocks(vertexIndexBlocks)
+		{
+			m_VertexIndexBlock.reserve(TRIANGLE_BLOCK_SIZE * 3);
+		}
+
+		// Both arrays were read, once the reader succeeded
+		bool IsComplete() const
+		{
+			return m_HasVertices && m_HasTriangles;
+		}
+
+		bool StartObject()
+		{
+			if (!BeginValue(true, false)) return false;
+
+			++m_Depth;
+			return true;
+		}
+
+		bool EndObject(const json::SizeType /*memberCount*/)
+		{
+			--m_Depth;
+			if (m_Depth == ROOT_OBJECT_DEPTH)
+				m_IsInGeometryObject = false;
+
+			return true;
+		}
+
+		bool StartArray()
+		{
+			if (!BeginValue(false, true)) return false;
+
+			++m_Depth;
+			return true;
+		}
+
+		bool EndArray(const json::SizeType /*elementCount*/)
+		{
+			--m_Depth;
+			if (m_Array == Member::Other) return true;
+
+			const Member array = std::exchange(m_Array, Member::Other);
+			return array == Member::Vertices ? EndVertices() : EndTriangles();
+		}
+
+		bool Key(const char* const name, const json::SizeType length, const bool /*copy*/)
+		{
+			const std::string_view key(name, length);
+			if (m_Depth == ROOT_OBJECT_DEPTH && !m_HasGeometryObject && key == "geometry_object")
+				m_PendingMember = Member::GeometryObject;
+			else if (m_IsInGeometryObject && m_Depth == GEOMETRY_OBJECT_DEPTH && !m_HasVertices && key == "vertices")
+				m_PendingMember = Member::Vertices;
+			else if (m_IsInGeometryObject && m_Depth == GEOMETRY_OBJECT_DEPTH && !m_HasTriangles && key == "triangles")
+				m_PendingMember = Member::Triangles;
+
+			return true;
+		}
+
+		bool Double(const double value)
+		{
+			if (m_Array != Member::Vertices) return Default();
+
+			m_VertexComponents[m_VertexComponentCount++] = static_cast<float>(value);
+			if (m_VertexComponentCount == 3)
+			{
+				m_Vertices.emplace_back(m_VertexComponents[0], m_VertexComponents[1], m_VertexComponents[2]);
+				m_VertexComponentCount = 0;
+			}
+
+			return true;
+		}
+
+		bool Uint(const unsigned value)
+		{
+			return Uint64(value);
+		}
+
+		bool Uint64(const uint64_t value)
+		{
+			if (m_Array != Member::Triangles) return Default();
+
+			++m_TriangleIndexCount;
+
+			// The indexes read before the vertices are checked once the vertex count is known
+			if (!m_AreVerticesRead)
+			{
+				m_PendingVertexIndexes.push_back(value);
+				return true;
+			}
+
+			return AddVertexIndex(value);
+		}
+
+		// Every other value, which is only allowed outside of the arrays
+		bool Default()
+		{
+			return BeginValue(false, false);
+		}
+
+	private:
+		enum class Member : uint8_t
+		{
+			Other,
+			GeometryObject,
+			Vertices,
+			Triangles
+		};
+
+		bool BeginValue(const bool isObject, const bool isArray)
+		{
+			// The arrays only hold numbers
+			if (m_Array != Member::Other) return false;
+			if (m_Depth == 0) return isObject;
+
+			switch (std::exchange(m_PendingMember, Member::Other))
+			{
+			case Member::GeometryObject:
+				m_IsInGeometryObject = m_HasGeometryObject = true;
+				return isObject;
+			case Member::Vertices:
+				m_Array = Member::Vertices;
+				m_HasVertices = true;
+				return isArray;
+			case Member::Triangles:
+				m_Array = Member::Triangles;
+				m_HasTriangles = true;
+				return isArray;
+			default:
+				return true;
+			}
+		}
+
+		bool EndVertices()
+		{
+			if (m_VertexComponentCount != 0) return false;
+
+			m_AreVerticesRead = true;
+			for (const uint64_t vertexIndex : m_PendingVertexIndexes)
+			{
+				if (!AddVertexIndex(vertexIndex)) return false;
+			}
+
+			m_PendingVertexIndexes = {};
+
+			// The rest of the triangles, if they were complete before the vertices
+			return PushVertexIndexBlock();
+		}
+
+		bool EndTriangles()
+		{
+			if (m_TriangleIndexCount % 3 != 0) return false;
+
+			return !m_AreVerticesRead || PushVertexIndexBlock();
+		}
+
+		bool AddVertexIndex(const uint64_t vertexIndex)
+		{
+			if (vertexIndex >= m_Vertices.size()) return false;
+
+			m_VertexIndexBlock.push_back(vertexIndex);
+			return m_VertexIndexBlock.size() < TRIANGLE_BLOCK_SIZE * 3 || PushVertexIndexBlock();
+		}
+
+		bool PushVertexIndexBlock()
+		{
+			if (m_VertexIndexBlock.empty()) return true;
+
+			const bool isPushed = m_VertexIndexBlocks.Push(std::move(m_VertexIndexBlock));
+			m_VertexIndexBlock = {};
+			m_VertexIndexBlock.reserve(TRIANGLE_BLOCK_SIZE * 3);
+
+			return isPushed;
+		}
+
+	private:
+		std::vector<Vector3f>& m_Vertices;
+		utils::BoundedQueue<VertexIndexBlock>& m_VertexIndexBlocks;
+
+		uint32_t m_Depth = 0;
+		Member m_PendingMember = Member::Other; // Of the key just read
+		Member m_Array = Member::Other; // Being read
+		bool m_IsInGeometryObject = false;
+		bool m_HasGeometryObject = false;
+		bool m_HasVertices = false;
+		bool m_HasTriangles = false;
+		bool m_AreVerticesRead = false;
+
+		std::array<float, 3> m_VertexComponents = {};
+		uint32_t m_VertexComponentCount = 0;
+
+		VertexIndexBlock m_VertexIndexBlock;
+		std::vector<uint64_t> m_PendingVertexIndexes; // Of the triangles before the vertices, if the file has them in that order
+		uint64_t m_TriangleIndexCount = 0;
+	};
+
+	struct AnalyzedTriangles
+	{
+		TriangleBuffer Triangles = TriangleBuffer(0);
+		Mesh::Statistics Statistics;
+		std::optional<std::pair<uint64_t, bool>> EdgeCountAndIsClosed;
+	};
+
+	// Same as Mesh::CalculateStatistics and Mesh::CalculateEdgeCountAndIsClosed, block by block as the triangles are parsed
+	// The vertices are complete before the first block is queued, the index type is known from then on
+	AnalyzedTriangles AnalyzeTriangles(utils::BoundedQueue<VertexIndexBlock>& vertexIndexBlocks, const std::vector<Vector3f>& vertices)
+	{
+		PROFILE_SCOPE("MeshFileReader::AnalyzeTriangles");
+
+		// The parser stops pushing if the analysis throws
+		const CancelOnExit cancelVertexIndexBlocks(vertexIndexBlocks);
+
+		AnalyzedTriangles result;
+		double areaSum = 0.0;
+
+		// Sorted runs of one block each, merged once the last block is analyzed
+		std::vector<uint64_t> edgeKeys;
+		std::vector<size_t> edgeKeyRunStarts = { 0 };
+		bool areEdgeKeysPacked = false;
+
+		bool isFirstBlock = true;
+		while (auto block = vertexIndexBlocks.Pop())
+		{
+			if (isFirstBlock)
+			{
+				result.Triangles = TriangleBuffer(vertices.size());
+				areEdgeKeysPacked = vertices.size() <= (uint64_t(1) << 32);
+				isFirstBlock = false;
+			}
+
+			result.Triangles.Visit(
+				[&](auto& typedTriangles) -> void
+				{
+					using Index = typename std::decay_t<decltype(typedTriangles)>::value_type::IndexType;
+
+					const auto addEdgeKey = [&edgeKeys](const uint64_t vertexIndex0, const uint64_t vertexIndex1) -> void
+						{
+							edgeKeys.push_back(std::min(vertexIndex0, vertexIndex1) << 32 | std::max(vertexIndex0, vertexIndex1));
+						};
+
+					for (size_t i = 0; i < block->size(); i += 3)
+					{
+						const uint64_t vertexIndex0 = (*block)[i];
+						const uint64_t vertexIndex1 = (*block)[i + 1];
+						const uint64_t vertexIndex2 = (*block)[i + 2];
+
+						typedTriangles.emplace_back(static_cast<Index>(vertexIndex0), static_cast<Index>(vertexIndex1), static_cast<Index>(vertexIndex2));
+
+						const Vector3f& vertex0 = vertices[vertexIndex0];
+						const auto edge1 = vertices[vertexIndex1] - vertex0;
+						const auto edge2 = vertices[vertexIndex2] - vertex0;
+						const float area = edge1.CrossProduct(edge2).Magnitude() / 2.f;
+
+						auto& statistics = result.Statistics;
+						if (area > EPSILON && (area < statistics.SmallestTriangleArea || statistics.SmallestTriangleArea == 0.f))
+							statistics.SmallestTriangleArea = area;
+
+						if (statistics.BiggestTriangleArea < area)
+							statistics.BiggestTriangleArea = area;
+
+						areaSum += area;
+
+						if (areEdgeKeysPacked)
+						{
+							addEdgeKey(vertexIndex0, vertexIndex1);
+							addEdgeKey(vertexIndex1, vertexIndex2);
+							addEdgeKey(vertexIndex2, vertexIndex0);
+						}
+					}
+				}
+			);
+
+			if (areEdgeKeysPacked)
+			{
+				std::sort(edgeKeys.begin() + edgeKeyRunStarts.back(), edgeKeys.end());
+				edgeKeyRunStarts.push_back(edgeKeys.size());
+			}
+		}
+
+		// The triangles grew block by block, the mesh keeps them
+		result.Triangles.Visit([](auto& typedTriangles) -> void { typedTriangles.shrink_to_fit(); });
+
+		const size_t triangleCount = result.Triangles.GetCount();
+		if (triangleCount > 0)
+			result.Statistics.AverageTriangleArea = static_cast<float>(areaSum / triangleCount);
+
+		if (!areEdgeKeysPacked)
+			return result;
+
+		utils::ParallelMerge(std::span(edgeKeys), std::span<const size_t>(edgeKeyRunStarts));
+
+		// Every edge of a closed mesh borders at least two triangles
+		uint64_t edgeCount = 0;
+		bool isClosed = true;
+		for (size_t i = 0; i < edgeKeys.size();)
+		{
+			size_t neighbourCount = 1;
+			while (i + neighbourCount < edgeKeys.size() && edgeKeys[i + neighbourCount] == edgeKeys[i])
+				++neighbourCount;
+
+			++edgeCount;
+			isClosed &= neighbourCount >= 2;
+			i += neighbourCount;
+		}
+
+		result.EdgeCountAndIsClosed = { edgeCount, isClosed };
+		return result;
+	}
+}
+
+/*static*/ std::optional<MeshFileReader::Contents> MeshFileReader::Read(const fs::path& filepath)
+{
+	PROFILE_SCOPE("MeshFileReader::Read");
+
+	std::ifstream file(filepath.c_str(), std::ios::binary);
+	if (!file.is_open())
+	{
+		LOG_ERROR("\"{}\" does not exist!", filepath.string());
+		return {};
+	}
+
+	Contents contents;
+
+	utils::BoundedQueue<ReadBlock> readBlocks(QUEUE_CAPACITY);
+	utils::BoundedQueue<VertexIndexBlock> vertexIndexBlocks(QUEUE_CAPACITY);
+
+	auto reading = std::async(std::launch::async,
+		[&file, &readBlocks]() -> void
+		{
+			ReadBlocks(file, readBlocks);
+		}
+	);
+
+	auto analysis = std::async(std::launch::async,
+		[&vertexIndexBlocks, &vertices = contents.Vertices]() -> AnalyzedTriangles
+		{
+			return AnalyzeTriangles(vertexIndexBlocks, vertices);
+		}
+	);
+
+	// Parsed on this thread, between the reading and the analysis
+	bool isValid = false;
+	{
+		PROFILE_SCOPE("MeshFileReader::Parse");
+
+		// The reading stops early if the parsing failed or threw, the analysis finishes the blocks queued so far
+		const CancelOnExit cancelReadBlocks(readBlocks);
+		const CloseOnExit closeVertexIndexBlocks(vertexIndexBlocks);
+
+		BlockStream stream(readBlocks);
+		MeshJsonHandler handler(contents.Vertices, vertexIndexBlocks);
+		json::Reader jsonReader;
+		isValid = !jsonReader.Parse(stream, handler).IsError() && handler.IsComplete();
+	}
+
+	// Rethrow what either stage threw
+	reading.get();
+	auto analyzedTriangles = analysis.get();
+
+	if (!isValid)
+	{
+		LOG_ERROR("\"{}\" has invalid format!", filepath.string());
+		return {};
+	}
+
+	contents.Vertices.shrink_to_fit();
+	if (analyzedTriangles.Triangles.GetCount() == 0)
+		analyzedTriangles.Triangles = TriangleBuffer(contents.Vertices.size());
+
+	contents.Triangles = std::move(analyzedTriangles.Triangles);
+	contents.Statistics = analyzedTriangles.Statistics;
+	contents.EdgeCountAndIsClosed = analyzedTriangles.EdgeCountAndIsClosed;
+
+	return contents;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Core/Mesh.h"
+#include "Core/TriangleBuffer.h"
+#include "Math/Vector3.h"
+
+// Reads JSON mesh files: { "geometry_object": { "vertices": [x0, y0, z0, ...], "triangles": [i0, i1, i2, ...] } }
+// Loading is a pipeline of three threads handing fixed-size blocks to each other through bounded queues: the file is
+// read in blocks, which are parsed as they arrive, and the parsed triangles are stored and analyzed in blocks while
+// the rest of the file is still being read. By the time the last byte is read, the triangle areas are summed and the
+// edge keys of all but the last block are sorted, only the sorted runs are left to merge
+class MeshFileReader
+{
+public:
+	struct Contents
+	{
+		std::vector<Vector3f> Vertices;
+		TriangleBuffer Triangles = TriangleBuffer(0);
+
+		// Of the vertices as read
+		Mesh::Statistics Statistics;
+
+		// Empty past 2^32 vertices, whose edge keys do not fit in 64 bits
+		std::optional<std::pair<uint64_t, bool>> EdgeCountAndIsClosed;
+	};
+
+public:
+	static std::optional<MeshFileReader::Contents> Read(const fs::path& filepath);
+};
\ No newline at end of file
@@ -0,0 +1,337 @@
+#include "corepch.h"
+#include "Core/MeshReorder.h"
+
+#include "Math/AABB.h"
+#include "Math/Morton.h"
+#include "Utils/ScratchArena.h"
+#include "Utils/ThreadUtils.h"
+
+namespace
+{
+	// Scoring of "Linear-Speed Vertex Cache Optimisation" by Tom Forsyth
+	constexpr uint32_t VERTEX_CACHE_SIZE = 32;
+	constexpr float CACHE_DECAY_POWER = 1.5f;
+	constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+	constexpr float VALENCE_BOOST_SCALE = 2.f;
+	constexpr float VALENCE_BOOST_POWER = 0.5f;
+	constexpr uint32_t MAX_TABLE_VALENCE = 32;
+
+	constexpr uint32_t INVALID_TRIANGLE = std::numeric_limits<uint32_t>::max();
+
+	// Batches are optimised independently, smaller ones would break up more runs of vertex reuse at their borders
+	constexpr size_t MIN_TRIANGLE_BATCH_SIZE = 1 << 16;
+
+	const std::array<float, VERTEX_CACHE_SIZE> CACHE_POSITION_SCORES = []() -> std::array<float, VERTEX_CACHE_SIZE>
+		{
+			std::array<float, VERTEX_CACHE_SIZE> scores = {};
+			for (uint32_t position = 0; position < VERTEX_CACHE_SIZE; ++position)
+			{
+				// The vertices of the last triangle get a fixed score, so the order does not degenerate into strips
+				scores[position] = position < 3 ? LAST_TRIANGLE_SCORE
+					: std::pow(1.f - static_cast<float>(position - 3) / (VERTEX_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+			}
+
+			return scores;
+		}();
+
+	const std::array<float, MAX_TABLE_VALENCE> VALENCE_SCORES = []() -> std::array<float, MAX_TABLE_VALENCE>
+		{
+			std::array<float, MAX_TABLE_VALENCE> scores = {};
+			for (uint32_t valence = 1; valence < MAX_TABLE_VALENCE; ++valence)
+				scores[valence] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(valence), -VALENCE_BOOST_POWER);
+
+			return scores;
+		}();
+
+	float GetVertexScore(const int32_t cachePosition, const uint32_t remainingTriangleCount)
+	{
+		if (remainingTriangleCount == 0) return -1.f;
+
+		// Vertices with few triangles left are finished first, rather than leaving lone triangles behind
+		const float valenceScore = remainingTriangleCount < MAX_TABLE_VALENCE ? VALENCE_SCORES[remainingTriangleCount]
+			: VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangleCount), -VALENCE_BOOST_POWER);
+
+		return (cachePosition >= 0 ? CACHE_POSITION_SCORES[cachePosition] : 0.f) + valenceScore;
+	}
+
+	// Returns the order in which to emit the triangles, whose vertices index [0, vertexCount)
+	// All its buffers, the order included, are allocated from the resource
+	std::pmr::vector<uint32_t> OptimizeVertexCache(std::span<const std::array<uint32_t, 3>> triangles, const uint32_t vertexCount,
+		std::pmr::memory_resource* const resource)
+	{
+		const uint32_t triangleCount = static_cast<uint32_t>(triangles.size());
+
+		// Triangles of each vertex, the ones not emitted yet are kept at the front of each list
+		std::pmr::vector<uint32_t> remainingTriangleCounts(vertexCount, 0, resource);
+		for (const auto& triangle : triangles)
+		{
+			for (const uint32_t vertex : triangle)
+				++remainingTriangleCounts[vertex];
+		}
+
+		std::pmr::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0, resource);
+		for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+			adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + remainingTriangleCounts[vertex];
+
+		std::pmr::vector<uint32_t> adjacency(adjacencyOffsets.back(), resource);
+		{
+			std::pmr::vector<uint32_t> insertPositions(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1, resource);
+			for (uint32_t triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+			{
+				for (const uint32_t vertex : triangles[triangleIndex])
+					adjacency[insertPositions[vertex]++] = triangleIndex;
+			}
+		}
+
+		std::pmr::vector<int32_t> cachePositions(vertexCount, -1, resource);
+		std::pmr::vector<float> vertexScores(vertexCount, resource);
+		for (uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+			vertexScores[vertex] = GetVertexScore(-1, remainingTriangleCounts[vertex]);
+
+		std::pmr::vector<bool> isEmitted(triangleCount, false, resource);
+		std::pmr::vector<uint32_t> order(resource);
+		order.reserve(triangleCount);
+
+		std::pmr::vector<uint32_t> cache(resource), newCache(resource);
+		cache.reserve(VERTEX_CACHE_SIZE + 3);
+		newCache.reserve(VERTEX_CACHE_SIZE + 3);
+
+		uint32_t bestTriangle = 0;
+		uint32_t nextInputTriangle = 0;
+
+		while (order.size() < triangleCount)
+		{
+			// When no cached vertex has triangles left, continue from the input order, which is already spatially sorted
+			if (bestTriangle == INVALID_TRIANGLE)
+			{
+				while (isEmitted[nextInputTriangle])
+					++nextInputTriangle;
+
+				bestTriangle = nextInputTriangle;
+			}
+
+			order.push_back(bestTriangle);
+			isEmitted[bestTriangle] = true;
+
+			const auto& triangle = triangles[bestTriangle];
+			for (const uint32_t vertex : triangle)
+			{
+				const auto begin = adjacency.begin() + adjacencyOffsets[vertex];
+				const auto end = begin + remainingTriangleCounts[vertex];
+				std::iter_swap(std::find(begin, end, bestTriangle), end - 1);
+				--remainingTriangleCounts[vertex];
+			}
+
+			// Least recently used cache, the vertices of the emitted triangle move to the front
+			newCache.clear();
+			for (const uint32_t vertex : triangle)
+			{
+				if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end())
+					newCache.push_back(vertex);
+			}
+
+			for (const uint32_t vertex : cache)
+			{
+				if (std::find(triangle.begin(), triangle.end(), vertex) == triangle.end())
+					newCache.push_back(vertex);
+			}
+
+			for (size_t position = 0; position < newCache.size(); ++position)
+			{
+				const uint32_t vertex = newCache[position];
+				cachePositions[vertex] = position < VERTEX_CACHE_SIZE ? static_cast<int32_t>(position) : -1;
+				vertexScores[vertex] = GetVertexScore(cachePositions[vertex], remainingTriangleCounts[vertex]);
+			}
+
+			newCache.resize(std::min<size_t>(newCache.size(), VERTEX_CACHE_SIZE));
+			std::swap(cache, newCache);
+
+			// Only the triangles of cached vertices changed score, the best of them is emitted next
+			bestTriangle = INVALID_TRIANGLE;
+			float bestScore = -1.f;
+			for (const uint32_t vertex : cache)
+			{
+				const uint32_t adjacencyOffset = adjacencyOffsets[vertex];
+				for (uint32_t i = 0; i < remainingTriangleCounts[vertex]; ++i)
+				{
+					const uint32_t triangleIndex = adjacency[adjacencyOffset + i];
+					const auto& candidate = triangles[triangleIndex];
+					const float score = vertexScores[candidate[0]] + vertexScores[candidate[1]] + vertexScores[candidate[2]];
+					if (score > bestScore)
+					{
+						bestScore = score;
+						bestTriangle = triangleIndex;
+					}
+				}
+			}
+		}
+
+		return order;
+	}
+}
+
+/*static*/ void MeshReorder::Reorder(std::vector<Vector3f>& vertices, TriangleBuffer& triangles)
+{
+	PROFILE_SCOPE("MeshReorder::Reorder");
+
+	ReorderVertices(vertices, triangles);
+	ReorderTriangles(triangles);
+}
+
+/*static*/ void MeshReorder::ReorderVertices(std::vector<Vector3f>& vertices, TriangleBuffer& triangles)
+{
+	PROFILE_SCOPE("MeshReorder::ReorderVertices");
+
+	AABBf bounds;
+	std::mutex boundsMtx;
+	utils::ParallelFor(vertices.size(),
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			AABBf chunkBounds;
+			for (size_t i = startIndex; i < endIndex; ++i)
+				chunkBounds.Extend(vertices[i]);
+
+			std::lock_guard lock(boundsMtx);
+			bounds.Extend(chunkBounds);
+		}
+	);
+
+	utils::ScratchArena scratchArena;
+	std::pmr::vector<std::pair<uint64_t, size_t>> mortonCodeToVertexIndex(vertices.size(), scratchArena.GetResource());
+	utils::ParallelFor(vertices.size(),
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			for (size_t i = startIndex; i < endIndex; ++i)
+				mortonCodeToVertexIndex[i] = { EncodeMorton3(vertices[i], bounds), i };
+		}
+	);
+
+	utils::ParallelSort(std::span(mortonCodeToVertexIndex));
+
+	triangles.Visit(
+		[&](auto& typedTriangles) -> void
+		{
+			using Index = typename std::decay_t<decltype(typedTriangles)>::value_type::IndexType;
+
+			std::vector<Vector3f> newVertices(vertices.size());
+			std::pmr::vector<Index> newVertexIndexes(vertices.size(), scratchArena.GetResource());
+			utils::ParallelFor(vertices.size(),
+				[&](const size_t startIndex, const size_t endIndex) -> void
+				{
+					for (size_t i = startIndex; i < endIndex; ++i)
+					{
+						const size_t vertexIndex = mortonCodeToVertexIndex[i].second;
+						newVertices[i] = vertices[vertexIndex];
+						newVertexIndexes[vertexIndex] = static_cast<Index>(i);
+					}
+				}
+			);
+
+			vertices = std::move(newVertices);
+
+			utils::ParallelFor(typedTriangles.size(),
+				[&](const size_t startIndex, const size_t endIndex) -> void
+				{
+					for (size_t i = startIndex; i < endIndex; ++i)
+					{
+						for (auto& vertexIndex : typedTriangles[i].VertexIndexes)
+							vertexIndex = newVertexIndexes[vertexIndex];
+					}
+				}
+			);
+		}
+	);
+}
+
+/*static*/ void MeshReorder::ReorderTriangles(TriangleBuffer& triangles)
+{
+	PROFILE_SCOPE("MeshReorder::ReorderTriangles");
+
+	triangles.Visit(
+		[](auto& typedTriangles) -> void
+		{
+			using Triangle = typename std::decay_t<decltype(typedTriangles)>::value_type;
+			using Index = typename Triangle::IndexType;
+
+			// With the vertices along a Morton curve, this puts triangles close in space close in memory
+			const auto getLowestVertexIndex = [](const Triangle& triangle) -> Index
+				{
+					return std::min({ triangle.VertexIndexes[0], triangle.VertexIndexes[1], triangle.VertexIndexes[2] });
+				};
+
+			utils::ParallelSort(std::span(typedTriangles),
+				[&getLowestVertexIndex](const Triangle& triangle, const Triangle& other) -> bool
+				{
+					return getLowestVertexIndex(triangle) < getLowestVertexIndex(other);
+				}
+			);
+
+			const size_t batchCount = std::clamp<size_t>(typedTriangles.size() / MIN_TRIANGLE_BATCH_SIZE, 1, utils::GetThreadCount());
+			utils::ParallelForEach(batchCount, static_cast<uint32_t>(batchCount),
+				[&](const size_t batchIndex) -> void
+				{
+					const std::span<Triangle> batch(typedTriangles.begin() + typedTriangles.size() * batchIndex / batchCount,
+						typedTriangles.begin() + typedTriangles.size() * (batchIndex + 1) / batchCount);
+
+					// Every buffer of the batch lives in the arena of its thread
+					utils::ScratchArena scratchArena;
+					std::pmr::memory_resource* const resource = scratchArena.GetResource();
+
+					// Local vertex indexes, so the optimisation only allocates for the vertices of its batch
+					std::pmr::vector<Index> batchVertices(resource);
+					batchVertices.reserve(batch.size() * 3);
+					for (const auto& triangle : batch)
+						batchVertices.insert(batchVertices.end(), triangle.VertexIndexes.begin(), triangle.VertexIndexes.end());
+
+					std::sort(batchVertices.begin(), batchVertices.end());
+					batchVertices.erase(std::unique(batchVertices.begin(), batchVertices.end()), batchVertices.end());
+
+					std::pmr::vector<std::array<uint32_t, 3>> localTriangles(batch.size(), resource);
+					for (size_t i = 0; i < batch.size(); ++i)
+					{
+						for (size_t j = 0; j < 3; ++j)
+						{
+							const auto it = std::lower_bound(batchVertices.begin(), batchVertices.end(), batch[i].VertexIndexes[j]);
+							localTriangles[i][j] = static_cast<uint32_t>(it - batchVertices.begin());
+						}
+					}
+
+					const auto order = OptimizeVertexCache(localTriangles, static_cast<uint32_t>(batchVertices.size()), resource);
+
+					std::pmr::vector<Triangle> orderedTriangles(resource);
+					orderedTriangles.reserve(batch.size());
+					for (const uint32_t triangleIndex : order)
+						orderedTriangles.push_back(batch[triangleIndex]);
+
+					std::copy(orderedTriangles.begin(), orderedTriangles.end(), batch.begin());
+				}
+			);
+		}
+	);
+}
+
+/*static*/ float MeshReorder::GetAverageCacheMissRatio(const TriangleBuffer& triangles, const size_t vertexCount, const uint32_t cacheSize /* = 32*/)
+{
+	const size_t triangleCount = triangles.GetCount();
+	if (triangleCount == 0) return 0.f;
+
+	// A vertex is in the FIFO cache if fewer than cacheSize vertices were loaded since it was
+	std::vector<uint64_t> loadTimes(vertexCount, 0);
+	uint64_t loadCount = 0;
+
+	triangles.Visit(
+		[&](const auto& typedTriangles) -> void
+		{
+			for (const auto& triangle : typedTriangles)
+			{
+				for (const auto vertexIndex : triangle.VertexIndexes)
+				{
+					if (loadTimes[vertexIndex] == 0 || loadCount - loadTimes[vertexIndex] >= cacheSize)
+						loadTimes[vertexIndex] = ++loadCount;
+				}
+			}
+		}
+	);
+
+	return static_cast<float>(loadCount) / triangleCount;
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Core/TriangleBuffer.h"
+#include "Math/Vector3.h"
+
+// Reorders the vertices and triangles of a mesh so that the passes over them read memory close to what they just read:
+// the vertices follow a Morton curve and the triangles are ordered for vertex reuse, both on every core
+class MeshReorder
+{
+public:
+	static void Reorder(std::vector<Vector3f>& vertices, TriangleBuffer& triangles);
+
+	// Sorts the vertices along a Morton curve over their bounds and remaps the triangles
+	static void ReorderVertices(std::vector<Vector3f>& vertices, TriangleBuffer& triangles);
+
+	// Sorts the triangles by their lowest vertex index, then orders batches of them with Forsyth's vertex cache optimisation
+	static void ReorderTriangles(TriangleBuffer& triangles);
+
+	// Vertices per triangle missing from a FIFO cache of the given size: 3 at worst, around 0.6 for well-ordered regular meshes
+	static float GetAverageCacheMissRatio(const TriangleBuffer& triangles, const size_t vertexCount, const uint32_t cacheSize = 32);
+};
\ No newline at end of file
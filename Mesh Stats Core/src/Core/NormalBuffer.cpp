@@ -0,0 +1,86 @@
+#include "corepch.h"
+#include "Core/NormalBuffer.h"
+
+#include "Utils/ThreadUtils.h"
+
+NormalBuffer::NormalBuffer(std::vector<Vector3f>&& normals, const bool isEncoded)
+{
+	if (!isEncoded)
+	{
+		m_Normals.emplace<std::vector<Vector3f>>(std::move(normals));
+		return;
+	}
+
+	auto& encodedNormals = m_Normals.emplace<std::vector<OctahedralNormal>>(normals.size());
+
+	std::mutex maxAngularErrorMtx;
+	utils::ParallelFor(normals.size(),
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			float maxAngularError = 0.f;
+			for (size_t i = startIndex; i < endIndex; ++i)
+			{
+				encodedNormals[i] = EncodeOctahedral(normals[i]);
+
+				// The cosine of such small angles would round to 1
+				const auto decodedNormal = DecodeOctahedral(encodedNormals[i]);
+				const float angle = std::atan2(normals[i].CrossProduct(decodedNormal).Magnitude(), normals[i].DotProduct(decodedNormal));
+				maxAngularError = std::max(maxAngularError, angle);
+			}
+
+			std::lock_guard lock(maxAngularErrorMtx);
+			m_MaxAngularError = std::max(m_MaxAngularError, maxAngularError);
+		}
+	);
+
+	normals = {};
+}
+
+size_t NormalBuffer::GetCount() const
+{
+	return std::visit([](const auto& normals) -> size_t { return normals.size(); }, m_Normals);
+}
+
+bool NormalBuffer::IsEncoded() const
+{
+	return std::holds_alternative<std::vector<OctahedralNormal>>(m_Normals);
+}
+
+size_t NormalBuffer::GetMemoryUsage() const
+{
+	return std::visit([](const auto& normals) -> size_t { return normals.capacity() * sizeof(normals[0]); }, m_Normals);
+}
+
+float NormalBuffer::GetMaxAngularError() const
+{
+	return m_MaxAngularError;
+}
+
+Vector3f NormalBuffer::Get(const size_t index) const
+{
+	if (const auto* const normals = std::get_if<std::vector<Vector3f>>(&m_Normals))
+		return (*normals)[index];
+
+	return DecodeOctahedral(std::get<std::vector<OctahedralNormal>>(m_Normals)[index]);
+}
+
+const Vector3f* NormalBuffer::GetData() const
+{
+	const auto* const normals = std::get_if<std::vector<Vector3f>>(&m_Normals);
+	return normals ? normals->data() : nullptr;
+}
+
+void NormalBuffer::Decode(const size_t firstIndex, std::span<Vector3f> normals) const
+{
+	ASSERT(firstIndex + normals.size() <= GetCount());
+
+	if (const auto* const floatNormals = std::get_if<std::vector<Vector3f>>(&m_Normals))
+	{
+		std::copy_n(floatNormals->begin() + firstIndex, normals.size(), normals.begin());
+		return;
+	}
+
+	const auto& encodedNormals = std::get<std::vector<OctahedralNormal>>(m_Normals);
+	for (size_t i = 0; i < normals.size(); ++i)
+		normals[i] = DecodeOctahedral(encodedNormals[firstIndex + i]);
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Math/Octahedral.h"
+#include "Math/Vector3.h"
+
+// Normals, either as floats or octahedral-encoded into 4 bytes each instead of 12, which keeps only their directions
+class NormalBuffer
+{
+public:
+	using Storage = std::variant<std::vector<Vector3f>, std::vector<OctahedralNormal>>;
+
+public:
+	NormalBuffer() = default;
+	NormalBuffer(std::vector<Vector3f>&& normals, const bool isEncoded); // The floats are released once encoded
+
+	size_t GetCount() const;
+	bool IsEncoded() const;
+	size_t GetMemoryUsage() const; // Bytes
+	float GetMaxAngularError() const; // Radians, measured while encoding, 0 for floats
+
+	Vector3f Get(const size_t index) const;
+	const Vector3f* GetData() const; // Null if encoded
+
+	// Decodes the normals from the first one on into the span, in a loop the compiler can vectorize
+	void Decode(const size_t firstIndex, std::span<Vector3f> normals) const;
+
+private:
+	NormalBuffer::Storage m_Normals;
+	float m_MaxAngularError = 0.f;
+};
\ No newline at end of file
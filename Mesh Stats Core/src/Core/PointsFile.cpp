@@ -0,0 +1,68 @@
+#include "corepch.h"
+#include "Core/PointsFile.h"
+
+#include "Utils/FileUtils.h"
+#include "Utils/ScratchArena.h"
+
+/*static*/ std::optional<std::vector<Vector3f>> PointsFile::LoadPoints(const fs::path& filepath)
+{
+	utils::ScratchArena scratchArena;
+
+	const auto fileContents = utils::ReadFile(filepath);
+	if (!fileContents)
+	{
+		LOG_ERROR("\"{}\" does not exist!", filepath.string());
+		return {};
+	}
+
+	const auto hasInvalidFormat = [&filepath](const bool condition) -> bool
+		{
+			if (!condition)
+			{
+				LOG_ERROR("\"{}\" has invalid format!", filepath.string());
+			}
+
+			return !condition;
+		};
+
+	utils::ScratchJsonDocument jsonDocument;
+	jsonDocument.Parse(fileContents->c_str());
+	if (hasInvalidFormat(jsonDocument.IsObject() &&
+		jsonDocument.HasMember("points"))) return {};
+
+	const auto& jsonPoints = jsonDocument["points"];
+	if (hasInvalidFormat(jsonPoints.IsArray() && jsonPoints.Size() % 3 == 0)) return {};
+
+	std::vector<Vector3f> points;
+	points.reserve(jsonPoints.Size() / 3);
+	for (json::SizeType i = 0; i < jsonPoints.Size(); i += 3)
+	{
+		const auto& jsonX = jsonPoints[i];
+		const auto& jsonY = jsonPoints[i + 1];
+		const auto& jsonZ = jsonPoints[i + 2];
+
+		if (hasInvalidFormat(jsonX.IsNumber() && jsonY.IsNumber() && jsonZ.IsNumber())) return {};
+		points.emplace_back(jsonX.GetFloat(), jsonY.GetFloat(), jsonZ.GetFloat());
+	}
+
+	return points;
+}
+
+/*static*/ bool PointsFile::SaveResults(const fs::path& filepath, const utils::BitSet& arePointsInside)
+{
+	json::StringBuffer jsonStringBuffer;
+	json::Writer<json::StringBuffer> jsonWriter(jsonStringBuffer);
+
+	// Streamed through the writer, a DOM of millions of values would be several times bigger than the output
+	jsonWriter.StartObject();
+	jsonWriter.Key("inside_count");
+	jsonWriter.Uint64(arePointsInside.Count());
+	jsonWriter.Key("inside");
+	jsonWriter.StartArray();
+	for (size_t i = 0; i < arePointsInside.GetSize(); ++i)
+		jsonWriter.Bool(arePointsInside[i]);
+	jsonWriter.EndArray();
+	jsonWriter.EndObject();
+
+	return utils::WriteFile(filepath, jsonStringBuffer.GetString());
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Math/Vector3.h"
+#include "Utils/BitSet.h"
+
+// JSON files with query points: { "points": [x0, y0, z0, x1, y1, z1, ...] }
+// and their results: { "inside_count": N, "inside": [true, false, ...] }
+class PointsFile
+{
+public:
+	static std::optional<std::vector<Vector3f>> LoadPoints(const fs::path& filepath);
+	static bool SaveResults(const fs::path& filepath, const utils::BitSet& arePointsInside);
+};
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "corepch.h"
+#include "Core/PositionBuffer.h"
+
+/*static*/ const char* PositionBuffer::GetEncodingName(const PositionBuffer::Encoding encoding)
+{
+	switch (encoding)
+	{
+	case Encoding::Float:
+		return "32-bit floats";
+	case Encoding::Quantized16:
+		return "16-bit quantized";
+	case Encoding::Quantized21:
+		return "21-bit quantized";
+	}
+
+	return "";
+}
+
+PositionBuffer::PositionBuffer(std::vector<Vector3f>&& positions)
+	: m_Positions(utils::SharedChunkedArray<Vector3f>(std::move(positions)))
+{
+}
+
+PositionBuffer::PositionBuffer(std::vector<Vector3f>&& positions, const PositionBuffer::Encoding encoding)
+{
+	switch (encoding)
+	{
+	case Encoding::Float:
+		m_Positions.emplace<utils::SharedChunkedArray<Vector3f>>(std::move(positions));
+		return;
+	case Encoding::Quantized16:
+		m_Positions.emplace<QuantizedPositions<16>>(positions);
+		break;
+	case Encoding::Quantized21:
+		m_Positions.emplace<QuantizedPositions<21>>(positions);
+		break;
+	}
+
+	positions = {};
+}
+
+PositionBuffer::PositionBuffer(PositionBuffer::Storage&& positions)
+	: m_Positions(std::move(positions))
+{
+}
+
+PositionBuffer PositionBuffer::Append(std::vector<Vector3f>&& positions) const
+{
+	return PositionBuffer(Visit(
+		[&positions](const auto& currentPositions) -> Storage
+		{
+			if constexpr (std::is_same_v<std::decay_t<decltype(currentPositions)>, utils::SharedChunkedArray<Vector3f>>)
+				return currentPositions.Append(std::move(positions));
+			else
+				return currentPositions.Append(positions);
+		}
+	));
+}
+
+size_t PositionBuffer::GetCount() const
+{
+	return Visit([](const auto& positions) -> size_t { return positions.size(); });
+}
+
+PositionBuffer::Encoding PositionBuffer::GetEncoding() const
+{
+	return static_cast<Encoding>(m_Positions.index());
+}
+
+bool PositionBuffer::IsQuantized() const
+{
+	return GetEncoding() != Encoding::Float;
+}
+
+size_t PositionBuffer::GetMemoryUsage() const
+{
+	return Visit([](const auto& positions) -> size_t { return positions.GetMemoryUsage(); });
+}
+
+size_t PositionBuffer::GetSharedMemoryUsage() const
+{
+	return Visit([](const auto& positions) -> size_t { return positions.GetSharedMemoryUsage(); });
+}
+
+float PositionBuffer::GetMaxError() const
+{
+	if (const auto* const positions = std::get_if<QuantizedPositions<16>>(&m_Positions))
+		return positions->GetMaxError();
+
+	if (const auto* const positions = std::get_if<QuantizedPositions<21>>(&m_Positions))
+		return positions->GetMaxError();
+
+	return 0.f;
+}
+
+Vector3f PositionBuffer::Get(const size_t index) const
+{
+	return Visit([index](const auto& positions) -> Vector3f { return positions[index]; });
+}
+
+const Vector3f* PositionBuffer::GetData() const
+{
+	const auto* const positions = std::get_if<utils::SharedChunkedArray<Vector3f>>(&m_Positions);
+	return positions ? positions->data() : nullptr;
+}
+
+std::vector<Vector3f> PositionBuffer::Decode() const
+{
+	if (const auto* const positions = std::get_if<utils::SharedChunkedArray<Vector3f>>(&m_Positions))
+	{
+		std::vector<Vector3f> copiedPositions;
+		copiedPositions.reserve(positions->size());
+		for (size_t chunkIndex = 0; chunkIndex < positions->GetChunkCount(); ++chunkIndex)
+		{
+			const auto chunk = positions->GetChunk(chunkIndex);
+			copiedPositions.insert(copiedPositions.end(), chunk.begin(), chunk.end());
+		}
+
+		return copiedPositions;
+	}
+
+	std::vector<Vector3f> decodedPositions(GetCount());
+	Visit(
+		[&decodedPositions](const auto& positions) -> void
+		{
+			if constexpr (!std::is_same_v<std::decay_t<decltype(positions)>, utils::SharedChunkedArray<Vector3f>>)
+			{
+				utils::ParallelFor(decodedPositions.size(),
+					[&](const size_t startIndex, const size_t endIndex) -> void
+					{
+						positions.Decode(startIndex, std::span(decodedPositions).subspan(startIndex, endIndex - startIndex));
+					}
+				);
+			}
+		}
+	);
+
+	return decodedPositions;
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "Math/AABB.h"
+#include "Math/Vector3.h"
+#include "Utils/SharedChunkedArray.h"
+#include "Utils/ThreadUtils.h"
+
+// Positions stored as integer coordinates on a grid of 2^Bits - 1 steps per axis over their bounds, 16 bits take
+// 6 bytes per position and 21 bits packed into 64 take 8, instead of the 12 of floats
+// Reads like a const std::vector<Vector3f>, so the algorithms are written once for both
+template <uint32_t Bits>
+class QuantizedPositions
+{
+public:
+	static_assert(Bits == 16 || Bits == 21);
+
+	using Code = std::conditional_t<Bits == 16, std::array<uint16_t, 3>, uint64_t>;
+
+	static constexpr uint32_t MAX_CODE = (1u << Bits) - 1;
+
+public:
+	explicit QuantizedPositions(std::span<const Vector3f> positions);
+
+	// These positions followed by the new ones, quantized on the same grid and clamped to its bounds
+	QuantizedPositions Append(std::span<const Vector3f> positions) const;
+
+	size_t size() const;
+	size_t GetMemoryUsage() const; // Bytes
+	size_t GetSharedMemoryUsage() const; // Bytes, see utils::SharedChunkedArray
+
+	// Decoded on every access, inlined into the loops of the algorithms
+	Vector3f operator[](const size_t index) const;
+
+	// Decodes the positions from the first one on into the span, in a loop the compiler can vectorize
+	void Decode(const size_t firstIndex, std::span<Vector3f> positions) const;
+
+	// Upper bound of the distance between a decoded position and the original one
+	float GetMaxError() const;
+
+private:
+	QuantizedPositions() = default;
+
+	std::vector<Code> Encode(std::span<const Vector3f> positions) const;
+	Vector3f Decode(const QuantizedPositions::Code& code) const;
+
+private:
+	utils::SharedChunkedArray<Code> m_Codes;
+	Vector3f m_Origin;
+	Vector3f m_Step;
+};
+
+// Vertex positions, either as floats or quantized, the algorithms are written once for any storage
+// and reach the positions through Visit
+// Immutable and shared by copies, a buffer made by Append shares the positions of the one it extends
+class PositionBuffer
+{
+public:
+	enum class Encoding : uint8_t
+	{
+		Float, // Exact, 12 bytes per position
+		Quantized16, // 6 bytes per position, off by up to 1 / 131070 of the bounds' extent on each axis
+		Quantized21 // 8 bytes per position, off by up to 1 / 4194302 of the bounds' extent on each axis
+	};
+
+	// In the order of the encodings
+	using Storage = std::variant<utils::SharedChunkedArray<Vector3f>, QuantizedPositions<16>, QuantizedPositions<21>>;
+
+	static const char* GetEncodingName(const PositionBuffer::Encoding encoding);
+
+public:
+	explicit PositionBuffer(std::vector<Vector3f>&& positions);
+	PositionBuffer(std::vector<Vector3f>&& positions, const PositionBuffer::Encoding encoding); // The floats are released once quantized
+
+	// These positions followed by the new ones, in the same encoding, only the new ones take memory
+	PositionBuffer Append(std::vector<Vector3f>&& positions) const;
+
+	size_t GetCount() const;
+	PositionBuffer::Encoding GetEncoding() const;
+	bool IsQuantized() const;
+	size_t GetMemoryUsage() const; // Bytes
+	size_t GetSharedMemoryUsage() const; // Bytes, of the positions also held by other buffers
+	float GetMaxError() const; // See QuantizedPositions::GetMaxError, 0 for floats
+
+	Vector3f Get(const size_t index) const;
+	const Vector3f* GetData() const; // Null if quantized or extending another buffer
+	std::vector<Vector3f> Decode() const;
+
+	// Calls the function with the utils::SharedChunkedArray<Vector3f> or QuantizedPositions holding the positions
+	template <typename Function>
+	decltype(auto) Visit(Function&& function) const;
+
+private:
+	explicit PositionBuffer(PositionBuffer::Storage&& positions);
+
+private:
+	PositionBuffer::Storage m_Positions;
+};
+
+template <uint32_t Bits>
+QuantizedPositions<Bits>::QuantizedPositions(std::span<const Vector3f> positions)
+{
+	AABBf bounds;
+	for (const auto& position : positions)
+		bounds.Extend(position);
+
+	m_Origin = bounds.IsValid() ? bounds.Min : Vector3f();
+	m_Step = bounds.IsValid() ? bounds.GetExtent() / static_cast<float>(MAX_CODE) : Vector3f();
+	m_Codes = utils::SharedChunkedArray<Code>(Encode(positions));
+}
+
+template <uint32_t Bits>
+QuantizedPositions<Bits> QuantizedPositions<Bits>::Append(std::span<const Vector3f> positions) const
+{
+	QuantizedPositions quantizedPositions;
+	quantizedPositions.m_Codes = m_Codes.Append(Encode(positions));
+	quantizedPositions.m_Origin = m_Origin;
+	quantizedPositions.m_Step = m_Step;
+
+	return quantizedPositions;
+}
+
+template <uint32_t Bits>
+std::vector<typename QuantizedPositions<Bits>::Code> QuantizedPositions<Bits>::Encode(std::span<const Vector3f> positions) const
+{
+	std::vector<Code> codes(positions.size());
+
+	Vector3f inverseStep;
+	for (size_t axis = 0; axis < 3; ++axis)
+		inverseStep[axis] = m_Step[axis] > 0.f ? 1.f / m_Step[axis] : 0.f;
+
+	utils::ParallelFor(positions.size(),
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			for (size_t i = startIndex; i < endIndex; ++i)
+			{
+				std::array<uint32_t, 3> coordinates;
+				for (size_t axis = 0; axis < 3; ++axis)
+				{
+					const float coordinate = std::round((positions[i][axis] - m_Origin[axis]) * inverseStep[axis]);
+					coordinates[axis] = static_cast<uint32_t>(std::clamp(coordinate, 0.f, static_cast<float>(MAX_CODE)));
+				}
+
+				if constexpr (Bits == 16)
+				{
+					codes[i] = { static_cast<uint16_t>(coordinates[0]), static_cast<uint16_t>(coordinates[1]), static_cast<uint16_t>(coordinates[2]) };
+				}
+				else
+				{
+					codes[i] = uint64_t(coordinates[0]) | uint64_t(coordinates[1]) << Bits | uint64_t(coordinates[2]) << 2 * Bits;
+				}
+			}
+		}
+	);
+
+	return codes;
+}
+
+template <uint32_t Bits>
+size_t QuantizedPositions<Bits>::size() const
+{
+	return m_Codes.size();
+}
+
+template <uint32_t Bits>
+size_t QuantizedPositions<Bits>::GetMemoryUsage() const
+{
+	return m_Codes.GetMemoryUsage();
+}
+
+template <uint32_t Bits>
+size_t QuantizedPositions<Bits>::GetSharedMemoryUsage() const
+{
+	return m_Codes.GetSharedMemoryUsage();
+}
+
+template <uint32_t Bits>
+Vector3f QuantizedPositions<Bits>::operator[](const size_t index) const
+{
+	return Decode(m_Codes[index]);
+}
+
+template <uint32_t Bits>
+void QuantizedPositions<Bits>::Decode(const size_t firstIndex, std::span<Vector3f> positions) const
+{
+	ASSERT(firstIndex + positions.size() <= m_Codes.size());
+
+	// Chunk by chunk, so that the inner loop reads the codes directly
+	const size_t endIndex = firstIndex + positions.size();
+	size_t chunkFirstIndex = 0;
+	for (size_t chunkIndex = 0; chunkIndex < m_Codes.GetChunkCount() && chunkFirstIndex < endIndex; ++chunkIndex)
+	{
+		const auto chunk = m_Codes.GetChunk(chunkIndex);
+		const size_t startIndex = std::max(firstIndex, chunkFirstIndex);
+		const size_t chunkEndIndex = std::min(endIndex, chunkFirstIndex + chunk.size());
+
+		for (size_t i = startIndex; i < chunkEndIndex; ++i)
+			positions[i - firstIndex] = Decode(chunk[i - chunkFirstIndex]);
+
+		chunkFirstIndex += chunk.size();
+	}
+}
+
+template <uint32_t Bits>
+Vector3f QuantizedPositions<Bits>::Decode(const Code& code) const
+{
+	std::array<uint32_t, 3> coordinates;
+	if constexpr (Bits == 16)
+	{
+		coordinates = { code[0], code[1], code[2] };
+	}
+	else
+	{
+		coordinates = { static_cast<uint32_t>(code & MAX_CODE), static_cast<uint32_t>(code >> Bits & MAX_CODE), static_cast<uint32_t>(code >> 2 * Bits) };
+	}
+
+	return
+	{
+		m_Origin.x + static_cast<float>(coordinates[0]) * m_Step.x,
+		m_Origin.y + static_cast<float>(coordinates[1]) * m_Step.y,
+		m_Origin.z + static_cast<float>(coordinates[2]) * m_Step.z
+	};
+}
+
+template <uint32_t Bits>
+float QuantizedPositions<Bits>::GetMaxError() const
+{
+	// Rounded to the closest grid point on every axis, then off by the rounding of the decoding's float operations
+	return m_Step.Magnitude() / 2.f + (m_Origin.Magnitude() + m_Step.Magnitude() * MAX_CODE) * std::numeric_limits<float>::epsilon();
+}
+
+template <typename Function>
+decltype(auto) PositionBuffer::Visit(Function&& function) const
+{
+	return std::visit(std::forward<Function>(function), m_Positions);
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+// Index is the type of the vertex indexes, see TriangleBuffer for how it is picked
+template <typename Index>
+struct Triangle
+{
+	using IndexType = Index;
+
+	std::array<Index, 3> VertexIndexes;
+
+	Triangle(const Index vertexIndex0, const Index vertexIndex1, const Index vertexIndex2);
+};
+
+using Triangle16 = Triangle<uint16_t>;
+using Triangle32 = Triangle<uint32_t>;
+using Triangle64 = Triangle<uint64_t>;
+
+template <typename Index>
+Triangle<Index>::Triangle(const Index vertexIndex0, const Index vertexIndex1, const Index vertexIndex2)
+	: VertexIndexes{ vertexIndex0, vertexIndex1, vertexIndex2 }
+{
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "corepch.h"
+#include "Core/TriangleBuffer.h"
+
+/*static*/ uint32_t TriangleBuffer::GetIndexSize(const size_t vertexCount)
+{
+	if (vertexCount <= static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1) return sizeof(uint16_t);
+	if (vertexCount <= static_cast<size_t>(std::numeric_limits<uint32_t>::max()) + 1) return sizeof(uint32_t);
+	return sizeof(uint64_t);
+}
+
+TriangleBuffer::TriangleBuffer(const size_t vertexCount)
+{
+	switch (GetIndexSize(vertexCount))
+	{
+	case sizeof(uint16_t):
+		m_Triangles.emplace<std::vector<Triangle16>>();
+		break;
+	case sizeof(uint32_t):
+		m_Triangles.emplace<std::vector<Triangle32>>();
+		break;
+	default:
+		m_Triangles.emplace<std::vector<Triangle64>>();
+		break;
+	}
+}
+
+size_t TriangleBuffer::GetCount() const
+{
+	return Visit([](const auto& triangles) -> size_t { return triangles.size(); });
+}
+
+uint32_t TriangleBuffer::GetIndexSize() const
+{
+	return Visit([](const auto& triangles) -> uint32_t { return sizeof(triangles[0].VertexIndexes[0]); });
+}
+
+size_t TriangleBuffer::GetMemoryUsage() const
+{
+	return Visit([](const auto& triangles) -> size_t { return triangles.capacity() * sizeof(triangles[0]); });
+}
+
+std::array<uint64_t, 3> TriangleBuffer::GetVertexIndexes(const size_t triangleIndex) const
+{
+	return Visit(
+		[triangleIndex](const auto& triangles) -> std::array<uint64_t, 3>
+		{
+			const auto& vertexIndexes = triangles[triangleIndex].VertexIndexes;
+			return { vertexIndexes[0], vertexIndexes[1], vertexIndexes[2] };
+		}
+	);
+}
+
+void TriangleBuffer::Reserve(const size_t triangleCount)
+{
+	Visit([triangleCount](auto& triangles) -> void { triangles.reserve(triangleCount); });
+}
\ No newline at end of file
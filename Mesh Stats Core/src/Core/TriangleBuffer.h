@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Core/Triangle.h"
+
+// Triangles stored with the narrowest vertex indexes able to address every vertex of the mesh,
+// the algorithms are written once for any index type and reach the triangles through Visit
+class TriangleBuffer
+{
+public:
+	using Storage = std::variant<std::vector<Triangle16>, std::vector<Triangle32>, std::vector<Triangle64>>;
+
+	// Bytes per vertex index: 2 up to 2^16 vertices, 4 up to 2^32 and 8 past that
+	static uint32_t GetIndexSize(const size_t vertexCount);
+
+public:
+	// Empty, with the index type for the given vertex count
+	explicit TriangleBuffer(const size_t vertexCount);
+
+	// The vertex indexes have to be lower than the vertex count, they are converted if their type differs
+	template <typename Index>
+	TriangleBuffer(std::vector<Triangle<Index>>&& triangles, const size_t vertexCount);
+
+	size_t GetCount() const;
+	uint32_t GetIndexSize() const;
+	size_t GetMemoryUsage() const; // Bytes
+
+	// Widened to 64 bits, for code which is not worth instantiating for every index type
+	std::array<uint64_t, 3> GetVertexIndexes(const size_t triangleIndex) const;
+
+	void Reserve(const size_t triangleCount);
+
+	// Calls the function with the std::vector of the stored triangle type
+	template <typename Function>
+	decltype(auto) Visit(Function&& function) const;
+	template <typename Function>
+	decltype(auto) Visit(Function&& function);
+
+private:
+	TriangleBuffer::Storage m_Triangles;
+};
+
+template <typename Index>
+TriangleBuffer::TriangleBuffer(std::vector<Triangle<Index>>&& triangles, const size_t vertexCount)
+	: TriangleBuffer(vertexCount)
+{
+	Visit(
+		[&triangles](auto& storedTriangles) -> void
+		{
+			using StoredIndex = typename std::decay_t<decltype(storedTriangles)>::value_type::IndexType;
+
+			if constexpr (std::is_same_v<StoredIndex, Index>)
+			{
+				storedTriangles = std::move(triangles);
+			}
+			else
+			{
+				storedTriangles.reserve(triangles.size());
+				for (const auto& triangle : triangles)
+				{
+					storedTriangles.emplace_back(static_cast<StoredIndex>(triangle.VertexIndexes[0]),
+						static_cast<StoredIndex>(triangle.VertexIndexes[1]), static_cast<StoredIndex>(triangle.VertexIndexes[2]));
+				}
+
+				triangles = {};
+			}
+		}
+	);
+}
+
+template <typename Function>
+decltype(auto) TriangleBuffer::Visit(Function&& function) const
+{
+	return std::visit(std::forward<Function>(function), m_Triangles);
+}
+
+template <typename Function>
+decltype(auto) TriangleBuffer::Visit(Function&& function)
+{
+	return std::visit(std::forward<Function>(function), m_Triangles);
+}
\ No newline at end of file
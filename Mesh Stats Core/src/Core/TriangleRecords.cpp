@@ -0,0 +1,236 @@
+#include "corepch.h"
+#include "Core/TriangleRecords.h"
+
+#include "Utils/ThreadUtils.h"
+
+namespace
+{
+	constexpr uint32_t FULL_BLOCK_MASK = (1u << TRIANGLE_BLOCK_SIZE) - 1;
+
+	// Mask of the lanes [firstLane, firstLane + count) of a block, count may go past the end of the block
+	uint32_t GetLaneMask(const uint32_t firstLane, const uint32_t count)
+	{
+		const uint32_t lastLane = std::min(firstLane + count, TRIANGLE_BLOCK_SIZE);
+		return (FULL_BLOCK_MASK >> (TRIANGLE_BLOCK_SIZE - lastLane)) & ~((1u << firstLane) - 1);
+	}
+}
+
+TriangleRecords::TriangleRecords(const PositionBuffer& vertices, const TriangleBuffer& triangles, const std::vector<uint32_t>& order)
+	: m_TriangleCount(0)
+{
+	ASSERT(order.size() == triangles.GetCount());
+	Init(vertices, triangles, &order);
+}
+
+TriangleRecords::TriangleRecords(const PositionBuffer& vertices, const TriangleBuffer& triangles)
+	: m_TriangleCount(0)
+{
+	Init(vertices, triangles, nullptr);
+}
+
+void TriangleRecords::Init(const PositionBuffer& vertices, const TriangleBuffer& triangles, const std::vector<uint32_t>* const order)
+{
+	ASSERT(triangles.GetCount() <= std::numeric_limits<uint32_t>::max());
+	m_TriangleCount = static_cast<uint32_t>(triangles.GetCount());
+
+	// The padding lanes are left as degenerate triangles (zero edges), which the kernels never report as hit
+	m_Blocks.resize((m_TriangleCount + TRIANGLE_BLOCK_SIZE - 1) / TRIANGLE_BLOCK_SIZE, TriangleBlock{});
+
+	vertices.Visit(
+		[&](const auto& typedVertices) -> void
+		{
+			triangles.Visit(
+				[&](const auto& typedTriangles) -> void
+				{
+					utils::ParallelFor(m_Blocks.size(),
+						[&](const size_t startIndex, const size_t endIndex) -> void
+						{
+							for (size_t blockIndex = startIndex; blockIndex < endIndex; ++blockIndex)
+							{
+								auto& block = m_Blocks[blockIndex];
+
+								for (uint32_t lane = 0; lane < TRIANGLE_BLOCK_SIZE; ++lane)
+								{
+									const size_t index = blockIndex * TRIANGLE_BLOCK_SIZE + lane;
+									if (index >= m_TriangleCount) break;
+
+									const auto& triangle = typedTriangles[order ? (*order)[index] : index];
+
+									const auto& vertex0 = typedVertices[triangle.VertexIndexes[0]];
+									const auto edge1 = typedVertices[triangle.VertexIndexes[1]] - vertex0;
+									const auto edge2 = typedVertices[triangle.VertexIndexes[2]] - vertex0;
+
+									block.Vertex0X[lane] = vertex0.x;
+									block.Vertex0Y[lane] = vertex0.y;
+									block.Vertex0Z[lane] = vertex0.z;
+									block.Edge1X[lane] = edge1.x;
+									block.Edge1Y[lane] = edge1.y;
+									block.Edge1Z[lane] = edge1.z;
+									block.Edge2X[lane] = edge2.x;
+									block.Edge2Y[lane] = edge2.y;
+									block.Edge2Z[lane] = edge2.z;
+								}
+							}
+						}
+					);
+				}
+			);
+		}
+	);
+}
+
+uint32_t TriangleRecords::GetTriangleCount() const
+{
+	return m_TriangleCount;
+}
+
+size_t TriangleRecords::GetMemoryUsage() const
+{
+	return sizeof(TriangleRecords) + m_Blocks.capacity() * sizeof(TriangleBlock);
+}
+
+const std::vector<TriangleBlock>& TriangleRecords::GetBlocks() const
+{
+	return m_Blocks;
+}
+
+Vector3f TriangleRecords::GetVertex0(const uint32_t index) const
+{
+	ASSERT(index < m_TriangleCount);
+
+	const auto& block = m_Blocks[index / TRIANGLE_BLOCK_SIZE];
+	const uint32_t lane = index % TRIANGLE_BLOCK_SIZE;
+	return { block.Vertex0X[lane], block.Vertex0Y[lane], block.Vertex0Z[lane] };
+}
+
+Vector3f TriangleRecords::GetEdge1(const uint32_t index) const
+{
+	ASSERT(index < m_TriangleCount);
+
+	const auto& block = m_Blocks[index / TRIANGLE_BLOCK_SIZE];
+	const uint32_t lane = index % TRIANGLE_BLOCK_SIZE;
+	return { block.Edge1X[lane], block.Edge1Y[lane], block.Edge1Z[lane] };
+}
+
+Vector3f TriangleRecords::GetEdge2(const uint32_t index) const
+{
+	ASSERT(index < m_TriangleCount);
+
+	const auto& block = m_Blocks[index / TRIANGLE_BLOCK_SIZE];
+	const uint32_t lane = index % TRIANGLE_BLOCK_SIZE;
+	return { block.Edge2X[lane], block.Edge2Y[lane], block.Edge2Z[lane] };
+}
+
+// Moller-Trumbore ray-triangle intersection algorithm (two-sided triangles version), one ray against 8 triangles
+// Same operations in the same order as Ray3::PointOfIntersectionWithTriangle, the early outs became lane masks
+uint32_t TriangleRecords::IntersectBlock(const Ray3f& ray, const size_t blockIndex) const
+{
+	TriangleBlock::Lanes distances;
+	return IntersectBlock(ray, blockIndex, distances);
+}
+
+// The distances along the ray are only meaningful for the lanes that are hit
+uint32_t TriangleRecords::IntersectBlock(const Ray3f& ray, const size_t blockIndex, TriangleBlock::Lanes& distances) const
+{
+	const auto& block = m_Blocks[blockIndex];
+	const auto& origin = ray.Origin;
+	const auto& direction = ray.Direction;
+
+	std::array<uint32_t, TRIANGLE_BLOCK_SIZE> isHit;
+	for (uint32_t lane = 0; lane < TRIANGLE_BLOCK_SIZE; ++lane)
+	{
+		const float pX = direction.y * block.Edge2Z[lane] - direction.z * block.Edge2Y[lane];
+		const float pY = direction.z * block.Edge2X[lane] - direction.x * block.Edge2Z[lane];
+		const float pZ = direction.x * block.Edge2Y[lane] - direction.y * block.Edge2X[lane];
+
+		const float determinant = pX * block.Edge1X[lane] + pY * block.Edge1Y[lane] + pZ * block.Edge1Z[lane];
+		const float inverseDeterminant = 1.f / determinant;
+
+		const float tX = origin.x - block.Vertex0X[lane];
+		const float tY = origin.y - block.Vertex0Y[lane];
+		const float tZ = origin.z - block.Vertex0Z[lane];
+		const float u = (pX * tX + pY * tY + pZ * tZ) * inverseDeterminant;
+
+		const float qX = tY * block.Edge1Z[lane] - tZ * block.Edge1Y[lane];
+		const float qY = tZ * block.Edge1X[lane] - tX * block.Edge1Z[lane];
+		const float qZ = tX * block.Edge1Y[lane] - tY * block.Edge1X[lane];
+		const float v = (qX * direction.x + qY * direction.y + qZ * direction.z) * inverseDeterminant;
+		const float t = (qX * block.Edge2X[lane] + qY * block.Edge2Y[lane] + qZ * block.Edge2Z[lane]) * inverseDeterminant;
+
+		isHit[lane] = (std::abs(determinant) >= EPSILON) & (u >= 0.f) & (u <= 1.f) & (v >= 0.f) & (u + v <= 1.f) & (t >= 0.f);
+		distances[lane] = t;
+	}
+
+	uint32_t hitMask = 0;
+	for (uint32_t lane = 0; lane < TRIANGLE_BLOCK_SIZE; ++lane)
+		hitMask |= isHit[lane] << lane;
+
+	return hitMask;
+}
+
+// Moller-Trumbore ray-triangle intersection algorithm (two-sided triangles version), 8 rays against one triangle
+uint32_t TriangleRecords::IntersectPacket(const RayPacket& packet, const uint32_t index) const
+{
+	const auto vertex0 = GetVertex0(index);
+	const auto edge1 = GetEdge1(index);
+	const auto edge2 = GetEdge2(index);
+	const auto& direction = packet.Direction;
+
+	// Everything that does not depend on the origin is shared by the whole packet
+	const auto pVector = direction.CrossProduct(edge2);
+	const float determinant = pVector.DotProduct(edge1);
+	if (IsZero(determinant)) // Rays are parallel to the triangle
+		return 0;
+
+	const float inverseDeterminant = 1.f / determinant;
+
+	std::array<uint32_t, RAY_PACKET_SIZE> isHit;
+	for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+	{
+		const float tX = packet.OriginX[lane] - vertex0.x;
+		const float tY = packet.OriginY[lane] - vertex0.y;
+		const float tZ = packet.OriginZ[lane] - vertex0.z;
+		const float u = (pVector.x * tX + pVector.y * tY + pVector.z * tZ) * inverseDeterminant;
+
+		const float qX = tY * edge1.z - tZ * edge1.y;
+		const float qY = tZ * edge1.x - tX * edge1.z;
+		const float qZ = tX * edge1.y - tY * edge1.x;
+		const float v = (qX * direction.x + qY * direction.y + qZ * direction.z) * inverseDeterminant;
+		const float t = (qX * edge2.x + qY * edge2.y + qZ * edge2.z) * inverseDeterminant;
+
+		isHit[lane] = (u >= 0.f) & (u <= 1.f) & (v >= 0.f) & (u + v <= 1.f) & (t >= 0.f);
+	}
+
+	uint32_t hitMask = 0;
+	for (uint32_t lane = 0; lane < RAY_PACKET_SIZE; ++lane)
+		hitMask |= isHit[lane] << lane;
+
+	return hitMask & packet.ActiveMask;
+}
+
+uint32_t TriangleRecords::CountRayIntersections(const Ray3f& ray) const
+{
+	uint32_t intersectionCount = 0;
+	for (size_t blockIndex = 0; blockIndex < m_Blocks.size(); ++blockIndex)
+		intersectionCount += std::popcount(IntersectBlock(ray, blockIndex));
+
+	return intersectionCount;
+}
+
+uint32_t TriangleRecords::CountRayIntersections(const Ray3f& ray, const uint32_t firstIndex, const uint32_t count) const
+{
+	ASSERT(firstIndex + count <= m_TriangleCount);
+
+	uint32_t intersectionCount = 0;
+	for (uint32_t index = firstIndex; index < firstIndex + count; )
+	{
+		const uint32_t blockIndex = index / TRIANGLE_BLOCK_SIZE;
+		const uint32_t firstLane = index % TRIANGLE_BLOCK_SIZE;
+		const uint32_t laneCount = firstIndex + count - index;
+
+		intersectionCount += std::popcount(IntersectBlock(ray, blockIndex) & GetLaneMask(firstLane, laneCount));
+		index += TRIANGLE_BLOCK_SIZE - firstLane;
+	}
+
+	return intersectionCount;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Core/PositionBuffer.h"
+#include "Core/TriangleBuffer.h"
+#include "Math/Ray3.h"
+#include "Math/Vector3.h"
+
+inline constexpr uint32_t TRIANGLE_BLOCK_SIZE = 8;
+inline constexpr uint32_t RAY_PACKET_SIZE = 8;
+
+// Precomputed Moller-Trumbore inputs (vertex0, edge1, edge2) of 8 triangles in SoA layout
+struct alignas(32) TriangleBlock
+{
+	using Lanes = std::array<float, TRIANGLE_BLOCK_SIZE>;
+
+	Lanes Vertex0X, Vertex0Y, Vertex0Z;
+	Lanes Edge1X, Edge1Y, Edge1Z;
+	Lanes Edge2X, Edge2Y, Edge2Z;
+};
+
+// Rays sharing the same direction, with their origins in SoA layout
+struct RayPacket
+{
+	using Lanes = std::array<float, RAY_PACKET_SIZE>;
+
+	Lanes OriginX = {};
+	Lanes OriginY = {};
+	Lanes OriginZ = {};
+	Vector3f Direction;
+	uint32_t ActiveMask = 0; // Bit i is set if ray i is in use
+};
+
+// Triangles of a mesh packed into blocks for the vectorised ray-triangle kernels
+// The kernels give the same results as Ray3::IntersectsTriangle, the lanes are processed without branches so compilers vectorise them
+class TriangleRecords
+{
+public:
+	// The triangles are stored in the given order, so that ranges of it can be tested (e.g. the leaves of a BVH)
+	TriangleRecords(const PositionBuffer& vertices, const TriangleBuffer& triangles, const std::vector<uint32_t>& order);
+	TriangleRecords(const PositionBuffer& vertices, const TriangleBuffer& triangles);
+
+	uint32_t GetTriangleCount() const;
+	size_t GetMemoryUsage() const;
+	const std::vector<TriangleBlock>& GetBlocks() const;
+	Vector3f GetVertex0(const uint32_t index) const;
+	Vector3f GetEdge1(const uint32_t index) const;
+	Vector3f GetEdge2(const uint32_t index) const;
+
+	// Bit i is set if the ray hits the i-th triangle of the block
+	uint32_t IntersectBlock(const Ray3f& ray, const size_t blockIndex) const;
+	uint32_t IntersectBlock(const Ray3f& ray, const size_t blockIndex, TriangleBlock::Lanes& distances) const;
+
+	// Bit i is set if the i-th active ray of the packet hits the triangle
+	uint32_t IntersectPacket(const RayPacket& packet, const uint32_t index) const;
+
+	uint32_t CountRayIntersections(const Ray3f& ray) const;
+	uint32_t CountRayIntersections(const Ray3f& ray, const uint32_t firstIndex, const uint32_t count) const;
+
+private:
+	void Init(const PositionBuffer& vertices, const TriangleBuffer& triangles, const std::vector<uint32_t>* const order);
+
+private:
+	std::vector<TriangleBlock> m_Blocks;
+	uint32_t m_TriangleCount;
+};
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "corepch.h"
+#include "Core/WindingNumber.h"
+
+#include "Math/Geometry.h"
+#include "Utils/ThreadUtils.h"
+
+namespace
+{
+	constexpr float INVERSE_4PI = 1.f / (4.f * PI);
+	constexpr uint32_t MAX_STACK_SIZE = 128;
+}
+
+FastWindingNumber::FastWindingNumber(const BVH& bvh)
+	: m_BVH(bvh)
+{
+	Build();
+}
+
+void FastWindingNumber::Build()
+{
+	PROFILE_SCOPE("FastWindingNumber::Build");
+
+	const auto& nodes = m_BVH.GetNodes();
+	const auto& records = m_BVH.GetTriangleRecords();
+
+	m_Clusters.resize(nodes.size());
+
+	// Leaves are summed from their triangles
+	utils::ParallelFor(nodes.size(),
+		[&](const size_t startIndex, const size_t endIndex) -> void
+		{
+			for (size_t nodeIndex = startIndex; nodeIndex < endIndex; ++nodeIndex)
+			{
+				const auto& node = nodes[nodeIndex];
+				if (!node.IsLeaf()) continue;
+
+				auto& cluster = m_Clusters[nodeIndex];
+				Vector3f weightedCentroidSum;
+				float areaSum = 0.f;
+
+				for (uint32_t i = node.FirstIndex; i < node.FirstIndex + node.TriangleCount; ++i)
+				{
+					const auto vertex0 = records.GetVertex0(i);
+					const auto edge1 = records.GetEdge1(i);
+					const auto edge2 = records.GetEdge2(i);
+
+					const auto areaNormal = edge1.CrossProduct(edge2) / 2.f;
+					const float area = areaNormal.Magnitude();
+					const auto centroid = vertex0 + (edge1 + edge2) / 3.f;
+
+					cluster.AreaNormal += areaNormal;
+					weightedCentroidSum += centroid * area;
+					areaSum += area;
+				}
+
+				cluster.Center = areaSum > 0.f ? weightedCentroidSum / areaSum : node.Bounds.GetCenter();
+
+				for (uint32_t i = node.FirstIndex; i < node.FirstIndex + node.TriangleCount; ++i)
+				{
+					const auto vertex0 = records.GetVertex0(i);
+					const auto vertex1 = vertex0 + records.GetEdge1(i);
+					const auto vertex2 = vertex0 + records.GetEdge2(i);
+
+					for (const auto& vertex : { vertex0, vertex1, vertex2 })
+						cluster.Radius = std::max(cluster.Radius, (vertex - cluster.Center).Magnitude());
+				}
+			}
+		}
+	);
+
+	// Children are always allocated after their parent, so walking backwards visits them first
+	for (size_t nodeIndex = nodes.size(); nodeIndex-- > 0; )
+	{
+		const auto& node = nodes[nodeIndex];
+		if (node.IsLeaf()) continue;
+
+		const auto& leftCluster = m_Clusters[node.FirstIndex];
+		const auto& rightCluster = m_Clusters[node.FirstIndex + 1];
+		auto& cluster = m_Clusters[nodeIndex];
+
+		const float leftArea = leftCluster.AreaNormal.Magnitude();
+		const float rightArea = rightCluster.AreaNormal.Magnitude();
+		const float areaSum = leftArea + rightArea;
+
+		cluster.AreaNormal = leftCluster.AreaNormal + rightCluster.AreaNormal;
+		cluster.Center = areaSum > 0.f
+			? (leftCluster.Center * leftArea + rightCluster.Center * rightArea) / areaSum
+			: node.Bounds.GetCenter();
+		cluster.Radius = std::max(
+			(leftCluster.Center - cluster.Center).Magnitude() + leftCluster.Radius,
+			(rightCluster.Center - cluster.Center).Magnitude() + rightCluster.Radius
+		);
+	}
+}
+
+const std::vector<FastWindingNumber::Cluster>& FastWindingNumber::GetClusters() const
+{
+	return m_Clusters;
+}
+
+size_t FastWindingNumber::GetMemoryUsage() const
+{
+	return sizeof(FastWindingNumber) + m_Clusters.capacity() * sizeof(FastWindingNumber::Cluster);
+}
+
+float FastWindingNumber::Evaluate(const Vector3f& point, const float accuracy /* = DEFAULT_ACCURACY */) const
+{
+	const auto& nodes = m_BVH.GetNodes();
+
+	std::array<uint32_t, MAX_STACK_SIZE> stack;
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	float solidAngle = 0.f;
+	while (stackSize > 0)
+	{
+		const uint32_t nodeIndex = stack[--stackSize];
+		const auto& node = nodes[nodeIndex];
+		const auto& cluster = m_Clusters[nodeIndex];
+
+		const auto toCenter = cluster.Center - point;
+		const float distanceSquared = toCenter.MagnitudeSquared();
+		const float farFieldDistance = accuracy * cluster.Radius;
+
+		if (distanceSquared > farFieldDistance * farFieldDistance)
+		{
+			// Dipole term of the cluster's expansion
+			const float distance = std::sqrt(distanceSquared);
+			solidAngle += toCenter.DotProduct(cluster.AreaNormal) / (distanceSquared * distance);
+		}
+		else if (node.IsLeaf())
+		{
+			solidAngle += EvaluateTriangles(point, node.FirstIndex, node.TriangleCount);
+		}
+		else
+		{
+			ASSERT(stackSize + 2 <= MAX_STACK_SIZE);
+			stack[stackSize++] = node.FirstIndex;
+			stack[stackSize++] = node.FirstIndex + 1;
+		}
+	}
+
+	return solidAngle * INVERSE_4PI;
+}
+
+float FastWindingNumber::EvaluateExact(const Vector3f& point) const
+{
+	return EvaluateTriangles(point, 0, m_BVH.GetTriangleRecords().GetTriangleCount()) * INVERSE_4PI;
+}
+
+float FastWindingNumber::EvaluateTriangles(const Vector3f& point, const uint32_t firstIndex, const uint32_t count) const
+{
+	const auto& records = m_BVH.GetTriangleRecords();
+
+	float solidAngle = 0.f;
+	for (uint32_t i = firstIndex; i < firstIndex + count; ++i)
+	{
+		const auto a = records.GetVertex0(i) - point;
+		const auto b = a + records.GetEdge1(i);
+		const auto c = a + records.GetEdge2(i);
+		solidAngle += SolidAngle(a, b, c);
+	}
+
+	return solidAngle;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Core/BVH.h"
+#include "Math/Vector3.h"
+
+// Generalized winding number of a triangle soup: ~1 inside, ~0 outside, also meaningful for open and non-manifold meshes
+// Far away clusters of triangles (the BVH nodes) are approximated by their dipole, close ones are summed exactly
+class FastWindingNumber
+{
+public:
+	struct Cluster
+	{
+		Vector3f Center; // Area-weighted centroid of the triangles
+		Vector3f AreaNormal; // Sum of the triangle normals scaled by their area
+		float Radius = 0.f; // Distance from the center to the farthest vertex
+	};
+
+	// Distance, in cluster radii, after which a cluster is approximated. Bigger is more accurate and slower
+	static constexpr float DEFAULT_ACCURACY = 2.f;
+
+public:
+	// The BVH must outlive the winding number
+	explicit FastWindingNumber(const BVH& bvh);
+
+	const std::vector<FastWindingNumber::Cluster>& GetClusters() const;
+	size_t GetMemoryUsage() const; // Bytes, without the BVH it refers to
+
+	float Evaluate(const Vector3f& point, const float accuracy = DEFAULT_ACCURACY) const;
+	float EvaluateExact(const Vector3f& point) const;
+
+private:
+	void Build();
+
+	float EvaluateTriangles(const Vector3f& point, const uint32_t firstIndex, const uint32_t count) const;
+
+private:
+	const BVH& m_BVH;
+	std::vector<FastWindingNumber::Cluster> m_Clusters; // One per BVH node
+};
\ No newline at end of file
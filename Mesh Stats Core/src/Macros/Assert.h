@@ -10,7 +10,7 @@
 #endif
 
 #ifdef DEBUG
-#	define ASSERT(expression) do { if (!(expression)) { LOG_ERROR("Assertion failed: \"{}\", File: {}, Line: {}", #expression, __FILE__, __LINE__); DEBUG_BREAK(); } } while(false)
+#	define ASSERT(expression) do { if (!(expression)) { LOG_ERROR("Assertion failed: \"{}\", File: {}, Line: {}", #expression, __FILE__, __LINE__); ::utils::Logger::Get().Flush(); DEBUG_BREAK(); } } while(false)
 #else
 #	define ASSERT(expression) do { if (!(expression)) abort(); } while(false)
 #endif
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "Utils/Logger.h"
+
+// Available in every configuration, the arguments are only evaluated if the level is enabled, see utils::Logger::SetLevel
+#define LOG(level, ...) do { if (::utils::Logger::IsEnabled(level)) ::utils::Logger::Get().Log(level, __VA_ARGS__); } while(false)
+
+#define LOG_INFO(...) LOG(::utils::LogLevel::Info, __VA_ARGS__)
+#define LOG_WARNING(...) LOG(::utils::LogLevel::Warning, __VA_ARGS__)
+#define LOG_ERROR(...) LOG(::utils::LogLevel::Error, __VA_ARGS__)
\ No newline at end of file
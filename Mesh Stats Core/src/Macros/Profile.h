@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Utils/Profiler.h"
+
+#define PROFILE_CONCATENATE_IMPL(a, b) a##b
+#define PROFILE_CONCATENATE(a, b) PROFILE_CONCATENATE_IMPL(a, b)
+
+#ifdef DISABLE_PROFILING
+#	define PROFILE_SCOPE(name)
+#else
+#	define PROFILE_SCOPE(name) const utils::ProfileScope PROFILE_CONCATENATE(profileScope, __LINE__)(name)
+#endif
\ No newline at end of file
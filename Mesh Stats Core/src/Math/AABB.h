@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Math/Math.h"
+#include "Math/Vector3.h"
+
+// Axis-aligned bounding box
+template <typename T>
+struct AABB
+{
+	Vector3<T> Min = { std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max() };
+	Vector3<T> Max = { std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest() };
+
+	bool IsValid() const;
+
+	Vector3<T> GetCenter() const;
+	Vector3<T> GetExtent() const;
+	T GetSurfaceArea() const;
+	uint32_t GetLongestAxis() const;
+
+	bool Contains(const Vector3<T>& point) const;
+	T DistanceSquaredTo(const Vector3<T>& point) const;
+
+	// Slab test against the ray [origin, +inf); the direction is passed inverted so it can be reused across boxes
+	bool IntersectsRay(const Vector3<T>& origin, const Vector3<T>& inverseDirection) const;
+
+	void Extend(const Vector3<T>& point);
+	void Extend(const AABB& other);
+};
+
+using AABBf = AABB<float>;
+using AABBd = AABB<double>;
+
+template <typename T>
+bool AABB<T>::IsValid() const
+{
+	return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z;
+}
+
+template <typename T>
+Vector3<T> AABB<T>::GetCenter() const
+{
+	return (Min + Max) / static_cast<T>(2);
+}
+
+template <typename T>
+Vector3<T> AABB<T>::GetExtent() const
+{
+	return Max - Min;
+}
+
+template <typename T>
+T AABB<T>::GetSurfaceArea() const
+{
+	if (!IsValid()) return 0;
+
+	const auto extent = GetExtent();
+	return 2 * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
+
+template <typename T>
+uint32_t AABB<T>::GetLongestAxis() const
+{
+	const auto extent = GetExtent();
+	if (extent.x >= extent.y && extent.x >= extent.z) return 0;
+	return extent.y >= extent.z ? 1 : 2;
+}
+
+template <typename T>
+bool AABB<T>::Contains(const Vector3<T>& point) const
+{
+	return Min.x <= point.x && point.x <= Max.x
+		&& Min.y <= point.y && point.y <= Max.y
+		&& Min.z <= point.z && point.z <= Max.z;
+}
+
+template <typename T>
+T AABB<T>::DistanceSquaredTo(const Vector3<T>& point) const
+{
+	const T dx = std::max({ Min.x - point.x, static_cast<T>(0), point.x - Max.x });
+	const T dy = std::max({ Min.y - point.y, static_cast<T>(0), point.y - Max.y });
+	const T dz = std::max({ Min.z - point.z, static_cast<T>(0), point.z - Max.z });
+	return dx * dx + dy * dy + dz * dz;
+}
+
+template <typename T>
+bool AABB<T>::IntersectsRay(const Vector3<T>& origin, const Vector3<T>& inverseDirection) const
+{
+	// fmin/fmax drop the NaNs produced by 0 * inf when the origin lies on a slab of an axis-parallel ray
+	const T tx1 = (Min.x - origin.x) * inverseDirection.x;
+	const T tx2 = (Max.x - origin.x) * inverseDirection.x;
+	T tMin = std::fmin(tx1, tx2);
+	T tMax = std::fmax(tx1, tx2);
+
+	const T ty1 = (Min.y - origin.y) * inverseDirection.y;
+	const T ty2 = (Max.y - origin.y) * inverseDirection.y;
+	tMin = std::fmax(tMin, std::fmin(ty1, ty2));
+	tMax = std::fmin(tMax, std::fmax(ty1, ty2));
+
+	const T tz1 = (Min.z - origin.z) * inverseDirection.z;
+	const T tz2 = (Max.z - origin.z) * inverseDirection.z;
+	tMin = std::fmax(tMin, std::fmin(tz1, tz2));
+	tMax = std::fmin(tMax, std::fmax(tz1, tz2));
+
+	return tMax >= std::fmax(tMin, static_cast<T>(0));
+}
+
+template <typename T>
+void AABB<T>::Extend(const Vector3<T>& point)
+{
+	Min = { std::min(Min.x, point.x), std::min(Min.y, point.y), std::min(Min.z, point.z) };
+	Max = { std::max(Max.x, point.x), std::max(Max.y, point.y), std::max(Max.z, point.z) };
+}
+
+template <typename T>
+void AABB<T>::Extend(const AABB& other)
+{
+	Min = { std::min(Min.x, other.Min.x), std::min(Min.y, other.Min.y), std::min(Min.z, other.Min.z) };
+	Max = { std::max(Max.x, other.Max.x), std::max(Max.y, other.Max.y), std::max(Max.z, other.Max.z) };
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Math/Math.h"
+#include "Math/Vector3.h"
+
+// Signed solid angle subtended by the triangle (a, b, c) with vertices given relative to the viewpoint
+// Van Oosterom-Strackee formula, positive when the viewpoint is behind the triangle (opposite to (b - a) x (c - a))
+template <typename T>
+T SolidAngle(const Vector3<T>& a, const Vector3<T>& b, const Vector3<T>& c)
+{
+	const T aLength = a.Magnitude();
+	const T bLength = b.Magnitude();
+	const T cLength = c.Magnitude();
+
+	const T numerator = a.DotProduct(b.CrossProduct(c));
+	const T denominator = aLength * bLength * cLength
+		+ a.DotProduct(b) * cLength
+		+ b.DotProduct(c) * aLength
+		+ c.DotProduct(a) * bLength;
+
+	return 2 * std::atan2(numerator, denominator);
+}
+
+// Point of the triangle (a, b, c) closest to p, found by the Voronoi region of the triangle that contains p
+template <typename T>
+Vector3<T> ClosestPointOnTriangle(const Vector3<T>& p, const Vector3<T>& a, const Vector3<T>& b, const Vector3<T>& c)
+{
+	const auto ab = b - a;
+	const auto ac = c - a;
+
+	// Vertex region of a
+	const auto ap = p - a;
+	const T d1 = ab.DotProduct(ap);
+	const T d2 = ac.DotProduct(ap);
+	if (d1 <= 0 && d2 <= 0)
+		return a;
+
+	// Vertex region of b
+	const auto bp = p - b;
+	const T d3 = ab.DotProduct(bp);
+	const T d4 = ac.DotProduct(bp);
+	if (d3 >= 0 && d4 <= d3)
+		return b;
+
+	// Edge region of ab
+	const T vc = d1 * d4 - d3 * d2;
+	if (vc <= 0 && d1 >= 0 && d3 <= 0)
+		return a + ab * (d1 / (d1 - d3));
+
+	// Vertex region of c
+	const auto cp = p - c;
+	const T d5 = ab.DotProduct(cp);
+	const T d6 = ac.DotProduct(cp);
+	if (d6 >= 0 && d5 <= d6)
+		return c;
+
+	// Edge region of ac
+	const T vb = d5 * d2 - d1 * d6;
+	if (vb <= 0 && d2 >= 0 && d6 <= 0)
+		return a + ac * (d2 / (d2 - d6));
+
+	// Edge region of bc
+	const T va = d3 * d6 - d5 * d4;
+	if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0)
+		return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+	// Face region
+	const T denominator = va + vb + vc;
+	if (denominator <= 0)
+		return a;
+
+	const T v = vb / denominator;
+	const T w = vc / denominator;
+	return a + ab * v + ac * w;
+}
\ No newline at end of file
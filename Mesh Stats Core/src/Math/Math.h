@@ -8,7 +8,7 @@ inline constexpr float PI = std::numbers::pi_v<float>;
 template <typename T>
 bool IsZero(const T value)
 {
-	return abs(value) < EPSILON;
+	return std::abs(value) < EPSILON;
 }
 
 template <typename T>
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Math/AABB.h"
+#include "Math/Vector3.h"
+
+inline constexpr uint32_t MORTON_BITS_PER_AXIS = 21;
+
+// Inserts two zero bits between each of the lower 21 bits of the value
+inline uint64_t SpreadBitsBy3(uint64_t value)
+{
+	value &= 0x1fffff;
+	value = (value | value << 32) & 0x1f00000000ffff;
+	value = (value | value << 16) & 0x1f0000ff0000ff;
+	value = (value | value << 8) & 0x100f00f00f00f00f;
+	value = (value | value << 4) & 0x10c30c30c30c30c3;
+	value = (value | value << 2) & 0x1249249249249249;
+	return value;
+}
+
+inline uint64_t EncodeMorton3(const uint32_t x, const uint32_t y, const uint32_t z)
+{
+	return SpreadBitsBy3(x) | SpreadBitsBy3(y) << 1 | SpreadBitsBy3(z) << 2;
+}
+
+// Morton code of the point quantized to a 2^21 grid over the bounds
+template <typename T>
+uint64_t EncodeMorton3(const Vector3<T>& point, const AABB<T>& bounds)
+{
+	static constexpr T MAX_COORDINATE = static_cast<T>((1u << MORTON_BITS_PER_AXIS) - 1);
+
+	const auto extent = bounds.GetExtent();
+	const auto quantize = [&](const size_t axis) -> uint32_t
+		{
+			if (extent[axis] <= 0) return 0;
+
+			const T normalized = std::clamp((point[axis] - bounds.Min[axis]) / extent[axis], static_cast<T>(0), static_cast<T>(1));
+			return static_cast<uint32_t>(normalized * MAX_COORDINATE);
+		};
+
+	return EncodeMorton3(quantize(0), quantize(1), quantize(2));
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Math/Vector3.h"
+
+// Unit vector projected on an octahedron, unfolded onto a square and stored as two 16-bit signed normalized values,
+// which spreads the directions almost uniformly over the codes, unlike spherical coordinates
+struct OctahedralNormal
+{
+	static constexpr int16_t MAX_CODE = std::numeric_limits<int16_t>::max();
+	static constexpr int16_t ZERO_CODE = std::numeric_limits<int16_t>::min(); // Outside the normalized range, marks a zero vector
+
+	int16_t X = 0;
+	int16_t Y = 0;
+};
+
+// Branchless, so that loops over many normals can be vectorized
+inline Vector3f DecodeOctahedral(const OctahedralNormal& encoded)
+{
+	const float x = static_cast<float>(encoded.X) / OctahedralNormal::MAX_CODE;
+	const float y = static_cast<float>(encoded.Y) / OctahedralNormal::MAX_CODE;
+	const float z = 1.f - std::abs(x) - std::abs(y);
+
+	// The lower half of the octahedron is folded over the diagonals of the square
+	const float fold = std::max(-z, 0.f);
+	Vector3f normal = { x >= 0.f ? x - fold : x + fold, y >= 0.f ? y - fold : y + fold, z };
+
+	// The octahedron lies between the unit sphere and a sphere of radius 1 / sqrt(3), so the magnitude is never 0
+	const float scale = encoded.X == OctahedralNormal::ZERO_CODE ? 0.f : 1.f / normal.Magnitude();
+	normal *= scale;
+	return normal;
+}
+
+// Picks the closest of the 4 codes around the projected point rather than just rounding it, which halves the error
+inline OctahedralNormal EncodeOctahedral(const Vector3f& normal)
+{
+	const float sumOfAbs = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+	if (sumOfAbs <= 0.f) return { OctahedralNormal::ZERO_CODE, 0 };
+
+	float x = normal.x / sumOfAbs;
+	float y = normal.y / sumOfAbs;
+	if (normal.z < 0.f)
+	{
+		const float foldedX = (1.f - std::abs(y)) * (x >= 0.f ? 1.f : -1.f);
+		const float foldedY = (1.f - std::abs(x)) * (y >= 0.f ? 1.f : -1.f);
+		x = foldedX;
+		y = foldedY;
+	}
+
+	const auto toCode = [](const float value) -> int16_t
+		{
+			return static_cast<int16_t>(std::clamp(value, -1.f, 1.f) * OctahedralNormal::MAX_CODE);
+		};
+
+	const Vector3f unitNormal = normal / normal.Magnitude();
+	const int16_t codeX = toCode(x), codeY = toCode(y);
+
+	OctahedralNormal bestEncoded;
+	float bestDotProduct = -2.f;
+	for (const int16_t offsetX : { 0, 1 })
+	{
+		for (const int16_t offsetY : { 0, 1 })
+		{
+			// Truncation rounds toward 0, so the other candidate is one step away from 0
+			const OctahedralNormal encoded =
+			{
+				static_cast<int16_t>(std::clamp<int>(codeX + (x >= 0.f ? offsetX : -offsetX), -OctahedralNormal::MAX_CODE, OctahedralNormal::MAX_CODE)),
+				static_cast<int16_t>(std::clamp<int>(codeY + (y >= 0.f ? offsetY : -offsetY), -OctahedralNormal::MAX_CODE, OctahedralNormal::MAX_CODE))
+			};
+
+			const float dotProduct = DecodeOctahedral(encoded).DotProduct(unitNormal);
+			if (dotProduct > bestDotProduct)
+			{
+				bestDotProduct = dotProduct;
+				bestEncoded = encoded;
+			}
+		}
+	}
+
+	return bestEncoded;
+}
\ No newline at end of file
@@ -28,6 +28,9 @@ struct Vector3
 	bool operator==(const Vector3& other) const;
 	bool operator!=(const Vector3& other) const;
 
+	T& operator[](const size_t index);
+	const T& operator[](const size_t index) const;
+
 	Vector3 operator+() const;
 	Vector3 operator-() const;
 
@@ -53,7 +56,7 @@ using Vector3d = Vector3<double>;
 template <typename T>
 T Vector3<T>::Magnitude() const
 {
-	return sqrt(MagnitudeSquared());
+	return std::sqrt(MagnitudeSquared());
 }
 
 template <typename T>
@@ -89,7 +92,7 @@ T Vector3<T>::AngleBetween(const Vector3& other) const
 	const T magnitudesMultiplied = Magnitude() * other.Magnitude();
 	ASSERT(magnitudesMultiplied > EPSILON);
 
-	return acos(DotProduct(other) / magnitudesMultiplied);
+	return std::acos(DotProduct(other) / magnitudesMultiplied);
 }
 
 template <typename T>
@@ -133,6 +136,20 @@ bool Vector3<T>::operator!=(const Vector3& other) const
 	return !(*this == other);
 }
 
+template <typename T>
+T& Vector3<T>::operator[](const size_t index)
+{
+	ASSERT(index < 3);
+	return index == 0 ? x : index == 1 ? y : z;
+}
+
+template <typename T>
+const T& Vector3<T>::operator[](const size_t index) const
+{
+	ASSERT(index < 3);
+	return index == 0 ? x : index == 1 ? y : z;
+}
+
 template <typename T>
 Vector3<T> Vector3<T>::operator+() const
 {
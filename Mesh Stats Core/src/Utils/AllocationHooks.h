@@ -0,0 +1,84 @@
+#pragma once
+
+// Replaces the global operator new and delete to count every heap allocation in utils::GetAllocationCounters
+// Has to be included in exactly one source file of an executable, it does nothing if DISABLE_MEMORY_TRACKING is defined
+
+#include "Utils/MemoryUtils.h"
+
+#ifndef DISABLE_MEMORY_TRACKING
+
+#include <cstdlib>
+#include <new>
+
+namespace utils::allocation_hooks
+{
+	// Stored right before every block, which is allocated with malloc and aligned by hand
+	struct BlockHeader
+	{
+		size_t Size;
+		void* Allocation;
+	};
+
+	inline void* Allocate(const size_t size, const size_t alignment) noexcept
+	{
+		const size_t headerSize = sizeof(BlockHeader);
+		const size_t padding = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? alignment : 0;
+
+		void* const allocation = std::malloc(size + headerSize + padding);
+		if (!allocation) return nullptr;
+
+		uintptr_t address = reinterpret_cast<uintptr_t>(allocation) + headerSize;
+		if (padding > 0)
+			address = (address + alignment - 1) & ~(uintptr_t(alignment) - 1);
+
+		auto* const header = reinterpret_cast<BlockHeader*>(address) - 1;
+		header->Size = size;
+		header->Allocation = allocation;
+
+		RecordAllocation(size);
+		return reinterpret_cast<void*>(address);
+	}
+
+	inline void Deallocate(void* const block) noexcept
+	{
+		if (!block) return;
+
+		const auto* const header = static_cast<BlockHeader*>(block) - 1;
+		RecordDeallocation(header->Size);
+		std::free(header->Allocation);
+	}
+
+	inline void* AllocateOrThrow(const size_t size, const size_t alignment)
+	{
+		void* const block = Allocate(size, alignment);
+		if (!block) throw std::bad_alloc();
+
+		return block;
+	}
+}
+
+static_assert(sizeof(utils::allocation_hooks::BlockHeader) % __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0);
+
+void* operator new(const size_t size) { return utils::allocation_hooks::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](const size_t size) { return utils::allocation_hooks::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(const size_t size, const std::nothrow_t&) noexcept { return utils::allocation_hooks::Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new[](const size_t size, const std::nothrow_t&) noexcept { return utils::allocation_hooks::Allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void* operator new(const size_t size, const std::align_val_t alignment) { return utils::allocation_hooks::AllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](const size_t size, const std::align_val_t alignment) { return utils::allocation_hooks::AllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(const size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept { return utils::allocation_hooks::Allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](const size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept { return utils::allocation_hooks::Allocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* const block) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete[](void* const block) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete(void* const block, const size_t) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete[](void* const block, const size_t) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete(void* const block, const std::nothrow_t&) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete[](void* const block, const std::nothrow_t&) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete(void* const block, const std::align_val_t) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete[](void* const block, const std::align_val_t) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete(void* const block, const size_t, const std::align_val_t) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete[](void* const block, const size_t, const std::align_val_t) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete(void* const block, const std::align_val_t, const std::nothrow_t&) noexcept { utils::allocation_hooks::Deallocate(block); }
+void operator delete[](void* const block, const std::align_val_t, const std::nothrow_t&) noexcept { utils::allocation_hooks::Deallocate(block); }
+
+#endif
\ No newline at end of file
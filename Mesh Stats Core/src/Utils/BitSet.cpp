@@ -0,0 +1,67 @@
+#include "corepch.h"
+#include "Utils/BitSet.h"
+
+namespace
+{
+	constexpr size_t BITS_PER_WORD = 64;
+
+	uint64_t GetBitMask(const size_t index)
+	{
+		return uint64_t(1) << (index % BITS_PER_WORD);
+	}
+}
+
+namespace utils
+{
+	BitSet::BitSet(const size_t size)
+		: m_Words((size + BITS_PER_WORD - 1) / BITS_PER_WORD, 0)
+		, m_Size(size)
+	{
+	}
+
+	size_t BitSet::GetSize() const
+	{
+		return m_Size;
+	}
+
+	size_t BitSet::Count() const
+	{
+		size_t count = 0;
+		for (const uint64_t word : m_Words)
+			count += std::popcount(word);
+
+		return count;
+	}
+
+	const std::vector<uint64_t>& BitSet::GetWords() const
+	{
+		return m_Words;
+	}
+
+	bool BitSet::Test(const size_t index) const
+	{
+		ASSERT(index < m_Size);
+		return m_Words[index / BITS_PER_WORD] & GetBitMask(index);
+	}
+
+	void BitSet::Set(const size_t index, const bool value /* = true */)
+	{
+		ASSERT(index < m_Size);
+
+		if (value)
+			m_Words[index / BITS_PER_WORD] |= GetBitMask(index);
+		else
+			m_Words[index / BITS_PER_WORD] &= ~GetBitMask(index);
+	}
+
+	void BitSet::SetAtomic(const size_t index)
+	{
+		ASSERT(index < m_Size);
+		std::atomic_ref<uint64_t>(m_Words[index / BITS_PER_WORD]).fetch_or(GetBitMask(index), std::memory_order_relaxed);
+	}
+
+	bool BitSet::operator[](const size_t index) const
+	{
+		return Test(index);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+namespace utils
+{
+	// Fixed-size set of bits packed into 64-bit words
+	class BitSet
+	{
+	public:
+		BitSet() = default;
+		explicit BitSet(const size_t size);
+
+		size_t GetSize() const;
+		size_t Count() const;
+		const std::vector<uint64_t>& GetWords() const;
+
+		bool Test(const size_t index) const;
+		void Set(const size_t index, const bool value = true);
+
+		// Safe to call from multiple threads, even for bits sharing the same word
+		void SetAtomic(const size_t index);
+
+		bool operator[](const size_t index) const;
+
+	private:
+		std::vector<uint64_t> m_Words;
+		size_t m_Size = 0;
+	};
+}
\ No newline at end of file
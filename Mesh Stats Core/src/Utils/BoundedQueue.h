@@ -0,0 +1,97 @@
+#pragma once
+
+namespace utils
+{
+	// Lock-free queue of at most a fixed number of elements between one producer thread and one consumer thread, which
+	// wait on its counters while it is full or empty, so a fast stage of a pipeline cannot run ahead of a slow one
+	// Either side can end the transfer: the producer closes the queue, the consumer cancels it
+	template<typename T>
+	class BoundedQueue
+	{
+	public:
+		explicit BoundedQueue(const size_t capacity);
+
+		BoundedQueue(const BoundedQueue&) = delete;
+		BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+		// Producer, waits while the queue is full. False if the consumer canceled, the element is then dropped
+		bool Push(T&& element);
+		void Close(); // No more elements, Pop returns empty once the queue is drained
+
+		// Consumer, waits while the queue is empty. Empty once the queue is closed and drained
+		std::optional<T> Pop();
+		void Cancel(); // No more pops, Push returns false from then on
+
+	private:
+		// Set in the counters by Close and Cancel, so that a side waiting for the other's counter to change also wakes up
+		static constexpr size_t ENDED_BIT = size_t(1) << (std::numeric_limits<size_t>::digits - 1);
+
+	private:
+		std::vector<T> m_Slots;
+
+		// Only increased by their own side, on separate cache lines
+		alignas(64) std::atomic<size_t> m_PushCount = 0;
+		alignas(64) std::atomic<size_t> m_PopCount = 0;
+	};
+
+	template<typename T>
+	BoundedQueue<T>::BoundedQueue(const size_t capacity)
+		: m_Slots(capacity)
+	{
+		ASSERT(capacity > 0);
+	}
+
+	template<typename T>
+	bool BoundedQueue<T>::Push(T&& element)
+	{
+		const size_t pushCount = m_PushCount.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			const size_t popCount = m_PopCount.load(std::memory_order_acquire);
+			if (popCount & ENDED_BIT) return false;
+			if (pushCount - popCount < m_Slots.size()) break;
+
+			m_PopCount.wait(popCount, std::memory_order_acquire);
+		}
+
+		m_Slots[pushCount % m_Slots.size()] = std::move(element);
+		m_PushCount.store(pushCount + 1, std::memory_order_release);
+		m_PushCount.notify_one();
+
+		return true;
+	}
+
+	template<typename T>
+	void BoundedQueue<T>::Close()
+	{
+		m_PushCount.fetch_or(ENDED_BIT, std::memory_order_release);
+		m_PushCount.notify_one();
+	}
+
+	template<typename T>
+	std::optional<T> BoundedQueue<T>::Pop()
+	{
+		const size_t popCount = m_PopCount.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			const size_t pushCount = m_PushCount.load(std::memory_order_acquire);
+			if ((pushCount & ~ENDED_BIT) != popCount) break;
+			if (pushCount & ENDED_BIT) return {};
+
+			m_PushCount.wait(pushCount, std::memory_order_acquire);
+		}
+
+		std::optional<T> element = std::move(m_Slots[popCount % m_Slots.size()]);
+		m_PopCount.store(popCount + 1, std::memory_order_release);
+		m_PopCount.notify_one();
+
+		return element;
+	}
+
+	template<typename T>
+	void BoundedQueue<T>::Cancel()
+	{
+		m_PopCount.fetch_or(ENDED_BIT, std::memory_order_release);
+		m_PopCount.notify_one();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "corepch.h"
+#include "Utils/FileUtils.h"
+
+namespace utils
+{
+	std::optional<std::string> ReadFile(const fs::path& filepath)
+	{
+		std::ifstream file(filepath.c_str());
+		if (!file.is_open()) return {};
+
+		return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	bool WriteFile(const fs::path& filepath, const std::string& data)
+	{
+		std::ofstream file(filepath.c_str());
+		if (!file.is_open()) return false;
+
+		file << data;
+		return true;
+	}
+
+	bool MatchesWildcard(const std::string_view text, const std::string_view pattern)
+	{
+		// Greedy matching with backtracking to the last '*'
+		size_t textIndex = 0, patternIndex = 0;
+		size_t starPatternIndex = std::string_view::npos, starTextIndex = 0;
+
+		while (textIndex < text.size())
+		{
+			if (patternIndex < pattern.size() && (pattern[patternIndex] == '?' || pattern[patternIndex] == text[textIndex]))
+			{
+				++textIndex;
+				++patternIndex;
+			}
+			else if (patternIndex < pattern.size() && pattern[patternIndex] == '*')
+			{
+				starPatternIndex = patternIndex++;
+				starTextIndex = textIndex;
+			}
+			else if (starPatternIndex != std::string_view::npos)
+			{
+				patternIndex = starPatternIndex + 1;
+				textIndex = ++starTextIndex;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		while (patternIndex < pattern.size() && pattern[patternIndex] == '*')
+			++patternIndex;
+
+		return patternIndex == pattern.size();
+	}
+
+	std::vector<fs::path> FindFiles(const std::string& pattern, const std::string& directoryExtension)
+	{
+		std::vector<fs::path> filepaths;
+		std::error_code error;
+
+		const fs::path patternPath(pattern);
+		const auto filenamePattern = patternPath.filename().string();
+
+		if (filenamePattern.find_first_of("*?") != std::string::npos)
+		{
+			const auto directory = patternPath.has_parent_path() ? patternPath.parent_path() : fs::path(".");
+			for (const auto& entry : fs::directory_iterator(directory, error))
+			{
+				if (entry.is_regular_file(error) && MatchesWildcard(entry.path().filename().string(), filenamePattern))
+					filepaths.push_back(entry.path());
+			}
+		}
+		else if (fs::is_directory(patternPath, error))
+		{
+			for (const auto& entry : fs::recursive_directory_iterator(patternPath, error))
+			{
+				if (entry.is_regular_file(error) && entry.path().extension() == directoryExtension)
+					filepaths.push_back(entry.path());
+			}
+		}
+		else if (fs::is_regular_file(patternPath, error))
+		{
+			filepaths.push_back(patternPath);
+		}
+
+		std::sort(filepaths.begin(), filepaths.end());
+		return filepaths;
+	}
+}
\ No newline at end of file
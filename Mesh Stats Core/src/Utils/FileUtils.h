@@ -0,0 +1,13 @@
+#pragma once
+
+namespace utils
+{
+	std::optional<std::string> ReadFile(const fs::path& filepath);
+	bool WriteFile(const fs::path& filepath, const std::string& data);
+
+	// '*' matches any sequence of characters, '?' matches any single character
+	bool MatchesWildcard(const std::string_view text, const std::string_view pattern);
+
+	// Expands a file, a directory (its files with the extension, recursively) or a wildcard pattern in the file name, sorted
+	std::vector<fs::path> FindFiles(const std::string& pattern, const std::string& directoryExtension);
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "corepch.h"
+#include "Utils/JobProgress.h"
+
+namespace utils
+{
+	JobProgress::JobProgress(const uint32_t stageCount)
+		: m_StageCount(std::max(stageCount, 1u))
+		, m_StageIndex(0)
+		, m_StageProgress(0.f)
+		, m_IsCanceled(false)
+	{
+	}
+
+	void JobProgress::BeginStage(const std::string& stageName)
+	{
+		{
+			std::lock_guard lock(m_StageNameMtx);
+
+			// The first stage has index 0
+			if (!m_StageName.empty())
+				++m_StageIndex;
+
+			m_StageName = stageName;
+		}
+
+		m_StageProgress = 0.f;
+	}
+
+	void JobProgress::SetStageProgress(const float stageProgress)
+	{
+		m_StageProgress = std::clamp(stageProgress, 0.f, 1.f);
+	}
+
+	std::string JobProgress::GetStageName() const
+	{
+		std::lock_guard lock(m_StageNameMtx);
+		return m_StageName;
+	}
+
+	uint32_t JobProgress::GetStageIndex() const
+	{
+		return m_StageIndex;
+	}
+
+	uint32_t JobProgress::GetStageCount() const
+	{
+		return m_StageCount;
+	}
+
+	float JobProgress::GetProgress() const
+	{
+		return std::min(1.f, (m_StageIndex + m_StageProgress) / m_StageCount);
+	}
+
+	void JobProgress::Cancel()
+	{
+		m_IsCanceled = true;
+	}
+
+	bool JobProgress::IsCanceled() const
+	{
+		return m_IsCanceled;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace utils
+{
+	// Shared between a background job, which reports its stages, and the thread waiting for it, which may cancel it
+	class JobProgress
+	{
+	public:
+		explicit JobProgress(const uint32_t stageCount);
+
+		void BeginStage(const std::string& stageName);
+		void SetStageProgress(const float stageProgress);
+
+		std::string GetStageName() const;
+		uint32_t GetStageIndex() const;
+		uint32_t GetStageCount() const;
+		float GetProgress() const; // Of the whole job, in [0, 1]
+
+		void Cancel();
+		bool IsCanceled() const;
+
+	private:
+		const uint32_t m_StageCount;
+		std::atomic<uint32_t> m_StageIndex;
+		std::atomic<float> m_StageProgress;
+		std::atomic<bool> m_IsCanceled;
+
+		mutable std::mutex m_StageNameMtx;
+		std::string m_StageName;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,212 @@
+#include "corepch.h"
+#include "Utils/Logger.h"
+
+#include "Utils/Profiler.h"
+#include "Utils/TimeUtils.h"
+
+namespace utils
+{
+	static_assert(std::has_single_bit(Logger::CAPACITY));
+
+	/*static*/ Logger& Logger::Get()
+	{
+		static Logger logger;
+		return logger;
+	}
+
+	/*static*/ LogLevel Logger::GetLevel()
+	{
+		return s_Level.load(std::memory_order_relaxed);
+	}
+
+	/*static*/ void Logger::SetLevel(const LogLevel level)
+	{
+		s_Level.store(level, std::memory_order_relaxed);
+	}
+
+	/*static*/ std::optional<LogLevel> Logger::ParseLevel(const std::string_view name)
+	{
+		for (const auto level : { LogLevel::Info, LogLevel::Warning, LogLevel::Error, LogLevel::None })
+		{
+			if (name == GetLevelName(level))
+				return level;
+		}
+
+		return std::nullopt;
+	}
+
+	/*static*/ const char* Logger::GetLevelName(const LogLevel level)
+	{
+		switch (level)
+		{
+		case LogLevel::Info: return "info";
+		case LogLevel::Warning: return "warning";
+		case LogLevel::Error: return "error";
+		case LogLevel::None: return "none";
+		}
+
+		return "unknown";
+	}
+
+	Logger::Logger()
+		: m_Entries(std::make_unique<Entry[]>(CAPACITY))
+		, m_WritePosition(0)
+		, m_ReadPosition(0)
+		, m_PublishedCount(0)
+		, m_WrittenCount(0)
+		, m_DroppedCount(0)
+		, m_ReportedDroppedCount(0)
+		, m_IsWriterWaiting(false)
+		, m_IsRunning(true)
+	{
+		for (uint64_t i = 0; i < CAPACITY; ++i)
+			m_Entries[i].Sequence.store(i, std::memory_order_relaxed);
+
+		m_WriterThread = std::thread(&Logger::RunWriter, this);
+	}
+
+	Logger::~Logger()
+	{
+		// Changing the count wakes the writer, which writes what is left and stops
+		m_IsRunning.store(false);
+		m_PublishedCount.fetch_add(1);
+		m_PublishedCount.notify_one();
+
+		m_WriterThread.join();
+	}
+
+	bool Logger::SetFile(const fs::path& filepath)
+	{
+		std::scoped_lock lock(m_FileMtx);
+
+		m_File = std::ofstream(filepath, std::ios::app);
+		return m_File.is_open();
+	}
+
+	void Logger::Flush()
+	{
+		const uint64_t publishedCount = m_PublishedCount.load(std::memory_order_acquire);
+
+		for (uint64_t writtenCount = m_WrittenCount.load(std::memory_order_acquire); writtenCount < publishedCount;
+			writtenCount = m_WrittenCount.load(std::memory_order_acquire))
+		{
+			m_WrittenCount.wait(writtenCount, std::memory_order_acquire);
+		}
+	}
+
+	uint64_t Logger::GetDroppedCount() const
+	{
+		return m_DroppedCount.load(std::memory_order_relaxed);
+	}
+
+	Logger::Entry* Logger::ClaimEntry(const LogLevel level)
+	{
+		// Bounded multi-producer queue: a producer owns the entry whose sequence matches the write position it advanced
+		uint64_t position = m_WritePosition.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Entry& entry = m_Entries[position & (CAPACITY - 1)];
+			const uint64_t sequence = entry.Sequence.load(std::memory_order_acquire);
+
+			if (sequence == position)
+			{
+				if (m_WritePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					entry.Time = std::chrono::system_clock::now();
+					entry.ThreadId = Profiler::GetThreadId();
+					entry.Level = level;
+					return &entry;
+				}
+			}
+			else if (sequence < position)
+			{
+				// The writer has not consumed the entry of the previous lap yet
+				m_DroppedCount.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			else
+			{
+				position = m_WritePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	void Logger::PublishEntry(Logger::Entry& entry)
+	{
+		entry.Sequence.store(entry.Sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+		// Sequentially consistent with the writer's flag, so either the writer sees the new count or it gets notified
+		m_PublishedCount.fetch_add(1);
+		if (m_IsWriterWaiting.load())
+			m_PublishedCount.notify_one();
+	}
+
+	void Logger::RunWriter()
+	{
+		while (true)
+		{
+			const uint64_t publishedCount = m_PublishedCount.load();
+			const bool isRunning = m_IsRunning.load();
+
+			uint64_t writtenCount = 0;
+			while (WriteNextEntry())
+				++writtenCount;
+
+			const uint64_t droppedCount = m_DroppedCount.load(std::memory_order_relaxed);
+			if (droppedCount > m_ReportedDroppedCount)
+			{
+				WriteLine(LogLevel::Warning, std::format("[{}] [WARNING] {} log messages were dropped, the buffer was full\n",
+					GetTime(std::chrono::system_clock::now()), droppedCount - m_ReportedDroppedCount));
+				m_ReportedDroppedCount = droppedCount;
+			}
+
+			if (writtenCount > 0)
+			{
+				std::cout.flush();
+				std::cerr.flush();
+				{
+					std::scoped_lock lock(m_FileMtx);
+					if (m_File.is_open())
+						m_File.flush();
+				}
+
+				m_WrittenCount.fetch_add(writtenCount, std::memory_order_release);
+				m_WrittenCount.notify_all();
+			}
+
+			if (!isRunning) break;
+			if (writtenCount > 0) continue;
+
+			m_IsWriterWaiting.store(true);
+			m_PublishedCount.wait(publishedCount);
+			m_IsWriterWaiting.store(false);
+		}
+	}
+
+	bool Logger::WriteNextEntry()
+	{
+		Entry& entry = m_Entries[m_ReadPosition & (CAPACITY - 1)];
+		if (entry.Sequence.load(std::memory_order_acquire) != m_ReadPosition + 1)
+			return false;
+
+		static constexpr std::array<const char*, 3> LEVEL_PREFIXES = { "[INFO]", "[WARNING]", "[ERROR]" };
+
+		WriteLine(entry.Level, std::format("[{}] [T{}] {} {}{}\n", GetTime(entry.Time), entry.ThreadId,
+			LEVEL_PREFIXES[static_cast<size_t>(entry.Level)], std::string_view(entry.Message, entry.Length), entry.IsTruncated ? "..." : ""));
+
+		entry.Sequence.store(m_ReadPosition + CAPACITY, std::memory_order_release);
+		++m_ReadPosition;
+		return true;
+	}
+
+	void Logger::WriteLine(const LogLevel level, const std::string_view line)
+	{
+		// In a single write, so the line and its newline are never split by the output of another thread
+		auto& stream = level == LogLevel::Error ? std::cerr : std::cout;
+		stream.write(line.data(), line.size());
+
+		std::scoped_lock lock(m_FileMtx);
+		if (m_File.is_open())
+			m_File.write(line.data(), line.size());
+	}
+}
\ No newline at end of file
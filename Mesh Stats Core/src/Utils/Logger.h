@@ -0,0 +1,114 @@
+#pragma once
+
+namespace utils
+{
+	enum class LogLevel : uint8_t
+	{
+		Info,
+		Warning,
+		Error,
+		None // Disables logging
+	};
+
+	// Messages are formatted on the calling thread into a lock-free ring buffer and written by a background thread,
+	// so logging never waits for I/O; when the buffer is full, messages are dropped and counted instead
+	class Logger
+	{
+	public:
+		static constexpr size_t CAPACITY = 1 << 12; // Messages
+		static constexpr size_t MAX_MESSAGE_LENGTH = 232; // Longer messages are truncated
+
+#ifdef DEBUG
+		static constexpr LogLevel DEFAULT_LEVEL = LogLevel::Info;
+#else
+		static constexpr LogLevel DEFAULT_LEVEL = LogLevel::Warning;
+#endif
+
+	public:
+		static Logger& Get();
+
+		// A single relaxed load, checked before any argument is formatted
+		static bool IsEnabled(const LogLevel level);
+		static LogLevel GetLevel();
+		static void SetLevel(const LogLevel level);
+
+		static std::optional<LogLevel> ParseLevel(const std::string_view name);
+		static const char* GetLevelName(const LogLevel level);
+
+		template<typename... Args>
+		void Log(const LogLevel level, const std::format_string<Args...> format, Args&&... args);
+
+		// Messages are also appended to the file, besides the standard output and error
+		bool SetFile(const fs::path& filepath);
+
+		// Blocks until every message logged before the call has been written
+		void Flush();
+
+		uint64_t GetDroppedCount() const;
+
+		~Logger();
+
+		Logger(const Logger&) = delete;
+		Logger& operator=(const Logger&) = delete;
+
+	private:
+		struct Entry
+		{
+			std::atomic<uint64_t> Sequence; // Equal to the write position once the entry is free, one past it once it is filled
+			std::chrono::system_clock::time_point Time;
+			uint32_t ThreadId;
+			uint16_t Length;
+			LogLevel Level;
+			bool IsTruncated;
+			char Message[MAX_MESSAGE_LENGTH];
+		};
+
+	private:
+		Logger();
+
+		// Returns the claimed entry, or nullptr if the buffer is full
+		Logger::Entry* ClaimEntry(const LogLevel level);
+		void PublishEntry(Logger::Entry& entry);
+
+		void RunWriter();
+		bool WriteNextEntry();
+		void WriteLine(const LogLevel level, const std::string_view line); // The line ends with its newline
+
+	private:
+		static inline std::atomic<LogLevel> s_Level = DEFAULT_LEVEL;
+
+		std::unique_ptr<Logger::Entry[]> m_Entries;
+		std::atomic<uint64_t> m_WritePosition;
+		uint64_t m_ReadPosition; // Only used by the writer thread
+
+		std::atomic<uint64_t> m_PublishedCount;
+		std::atomic<uint64_t> m_WrittenCount;
+		std::atomic<uint64_t> m_DroppedCount;
+		uint64_t m_ReportedDroppedCount; // Only used by the writer thread
+
+		std::mutex m_FileMtx;
+		std::ofstream m_File;
+
+		std::atomic<bool> m_IsWriterWaiting; // Producers only notify the writer while it waits
+		std::atomic<bool> m_IsRunning;
+		std::thread m_WriterThread;
+	};
+
+	inline bool Logger::IsEnabled(const LogLevel level)
+	{
+		return level >= s_Level.load(std::memory_order_relaxed);
+	}
+
+	template<typename... Args>
+	void Logger::Log(const LogLevel level, const std::format_string<Args...> format, Args&&... args)
+	{
+		Entry* const entry = ClaimEntry(level);
+		if (!entry) return;
+
+		const auto result = std::format_to_n(entry->Message, MAX_MESSAGE_LENGTH, format, std::forward<Args>(args)...);
+		entry->Length = static_cast<uint16_t>(std::min<size_t>(result.size, MAX_MESSAGE_LENGTH));
+		entry->IsTruncated = static_cast<size_t>(result.size) > MAX_MESSAGE_LENGTH;
+
+		PublishEntry(*entry);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "corepch.h"
+#include "Utils/MemoryUtils.h"
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+	#include <psapi.h>
+#elif defined(__linux__)
+	#include <sys/resource.h>
+#endif
+
+namespace
+{
+	std::atomic<size_t> g_CurrentBytes = 0;
+	std::atomic<size_t> g_PeakBytes = 0;
+	std::atomic<uint64_t> g_AllocationCount = 0;
+	std::atomic<uint64_t> g_DeallocationCount = 0;
+
+	// Every active scope owns a bit of the mask and the peak in its slot, which every allocation raises
+	std::atomic<uint64_t> g_ActiveScopeMask = 0;
+	std::array<std::atomic<size_t>, utils::AllocationScope::MAX_ACTIVE_SCOPE_COUNT> g_ScopePeakBytes;
+	static_assert(utils::AllocationScope::MAX_ACTIVE_SCOPE_COUNT <= 64);
+
+	// Only the outermost scope of a thread registers, the scopes nested in it are part of the same operation
+	std::atomic<uint32_t> g_ActiveThreadCount = 0;
+	std::atomic<uint64_t> g_StartedScopeCount = 0;
+	thread_local uint32_t t_ScopeDepth = 0;
+
+	void UpdatePeak(std::atomic<size_t>& peak, const size_t value)
+	{
+		size_t currentPeak = peak.load(std::memory_order_relaxed);
+		while (value > currentPeak && !peak.compare_exchange_weak(currentPeak, value, std::memory_order_relaxed));
+	}
+
+#if defined(__linux__)
+	// Reads a "<key>: <value> kB" line of /proc/self/status
+	size_t ReadProcStatusBytes(const std::string_view key)
+	{
+		std::ifstream file("/proc/self/status");
+		std::string line;
+		while (std::getline(file, line))
+		{
+			if (!line.starts_with(key) || line.size() <= key.size() || line[key.size()] != ':')
+				continue;
+
+			const auto valueStart = line.find_first_not_of(" \t", key.size() + 1);
+			if (valueStart == std::string::npos)
+				return 0;
+
+			size_t kilobytes = 0;
+			std::from_chars(line.data() + valueStart, line.data() + line.size(), kilobytes);
+			return kilobytes * 1024;
+		}
+
+		return 0;
+	}
+#endif
+}
+
+namespace utils
+{
+	size_t GetCurrentResidentMemory()
+	{
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS counters{};
+		return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.WorkingSetSize : 0;
+#elif defined(__linux__)
+		return ReadProcStatusBytes("VmRSS");
+#else
+		return 0;
+#endif
+	}
+
+	size_t GetPeakResidentMemory()
+	{
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS counters{};
+		return GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) ? counters.PeakWorkingSetSize : 0;
+#elif defined(__linux__)
+		// VmHWM follows ResetPeakResidentMemory, ru_maxrss (in kilobytes) does not
+		if (const size_t peak = ReadProcStatusBytes("VmHWM"))
+			return peak;
+
+		rusage usage{};
+		return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<size_t>(usage.ru_maxrss) * 1024 : 0;
+#else
+		return 0;
+#endif
+	}
+
+	std::string FormatBytes(const size_t bytes)
+	{
+		static constexpr std::array<const char*, 5> UNITS = { "B", "KB", "MB", "GB", "TB" };
+
+		double value = static_cast<double>(bytes);
+		size_t unitIndex = 0;
+		while (value >= 1024.0 && unitIndex + 1 < UNITS.size())
+		{
+			value /= 1024.0;
+			++unitIndex;
+		}
+
+		return unitIndex == 0 ? std::format("{} B", bytes) : std::format("{:.2f} {}", value, UNITS[unitIndex]);
+	}
+
+	bool ResetPeakResidentMemory()
+	{
+#if defined(__linux__)
+		std::ofstream file("/proc/self/clear_refs");
+		file << "5";
+		file.flush();
+		return file.good();
+#else
+		return false;
+#endif
+	}
+}
+
+namespace utils
+{
+	bool IsAllocationTrackingEnabled()
+	{
+		// The hooks count the allocations of the static initialization, before any caller can ask
+		return g_AllocationCount.load(std::memory_order_relaxed) > 0;
+	}
+
+	AllocationCounters GetAllocationCounters()
+	{
+		AllocationCounters counters;
+		counters.CurrentBytes = g_CurrentBytes.load(std::memory_order_relaxed);
+		counters.PeakBytes = g_PeakBytes.load(std::memory_order_relaxed);
+		counters.AllocationCount = g_AllocationCount.load(std::memory_order_relaxed);
+		counters.DeallocationCount = g_DeallocationCount.load(std::memory_order_relaxed);
+		return counters;
+	}
+
+	void RecordAllocation(const size_t size)
+	{
+		const size_t currentBytes = g_CurrentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+		UpdatePeak(g_PeakBytes, currentBytes);
+		g_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+		for (uint64_t activeScopeMask = g_ActiveScopeMask.load(std::memory_order_relaxed); activeScopeMask != 0; activeScopeMask &= activeScopeMask - 1)
+			UpdatePeak(g_ScopePeakBytes[std::countr_zero(activeScopeMask)], currentBytes);
+	}
+
+	void RecordDeallocation(const size_t size)
+	{
+		g_CurrentBytes.fetch_sub(size, std::memory_order_relaxed);
+		g_DeallocationCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	AllocationScope::AllocationScope()
+		: m_StartBytes(g_CurrentBytes.load(std::memory_order_relaxed))
+		, m_StartAllocationCount(g_AllocationCount.load(std::memory_order_relaxed))
+		, m_StartScopeCount(0)
+		, m_StartActiveThreadCount(0)
+		, m_SlotIndex(MAX_ACTIVE_SCOPE_COUNT)
+		, m_IsStopped(false)
+	{
+		if (t_ScopeDepth++ == 0)
+		{
+			m_StartActiveThreadCount = g_ActiveThreadCount.fetch_add(1) + 1;
+			m_StartScopeCount = g_StartedScopeCount.fetch_add(1) + 1;
+		}
+		else
+		{
+			m_StartActiveThreadCount = g_ActiveThreadCount.load();
+			m_StartScopeCount = g_StartedScopeCount.load();
+		}
+
+		uint64_t activeScopeMask = g_ActiveScopeMask.load(std::memory_order_relaxed);
+		while (true)
+		{
+			const uint32_t slotIndex = std::countr_one(activeScopeMask);
+			if (slotIndex >= MAX_ACTIVE_SCOPE_COUNT) break;
+
+			if (g_ActiveScopeMask.compare_exchange_weak(activeScopeMask, activeScopeMask | (uint64_t(1) << slotIndex), std::memory_order_acq_rel))
+			{
+				m_SlotIndex = slotIndex;
+				g_ScopePeakBytes[slotIndex].store(m_StartBytes, std::memory_order_relaxed);
+				break;
+			}
+		}
+	}
+
+	AllocationScope::~AllocationScope()
+	{
+		if (!m_IsStopped)
+			Stop();
+	}
+
+	AllocationScope::Result AllocationScope::Stop()
+	{
+		ASSERT(!m_IsStopped);
+		m_IsStopped = true;
+
+		size_t peakBytes = g_CurrentBytes.load(std::memory_order_relaxed);
+		if (m_SlotIndex < MAX_ACTIVE_SCOPE_COUNT)
+		{
+			peakBytes = std::max(peakBytes, g_ScopePeakBytes[m_SlotIndex].load(std::memory_order_relaxed));
+			g_ActiveScopeMask.fetch_and(~(uint64_t(1) << m_SlotIndex), std::memory_order_acq_rel);
+		}
+
+		Result result;
+		result.PeakBytes = peakBytes > m_StartBytes ? peakBytes - m_StartBytes : 0;
+		result.AllocationCount = g_AllocationCount.load(std::memory_order_relaxed) - m_StartAllocationCount;
+
+		// Another thread's scope was either active at the start or started since
+		result.IsExclusive = m_StartActiveThreadCount == 1 && g_StartedScopeCount.load() == m_StartScopeCount;
+		if (--t_ScopeDepth == 0)
+			g_ActiveThreadCount.fetch_sub(1);
+
+		return result;
+	}
+}
\ No newline at end of file
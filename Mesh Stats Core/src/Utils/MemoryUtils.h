@@ -0,0 +1,66 @@
+#pragma once
+
+namespace utils
+{
+	// Resident set size of the process in bytes, 0 where it cannot be queried
+	size_t GetCurrentResidentMemory();
+	size_t GetPeakResidentMemory();
+
+	// Restarts the peak from the current resident set size, only supported on Linux
+	bool ResetPeakResidentMemory();
+
+	// In the biggest unit that keeps the value at least 1, like "1.50 MB"
+	std::string FormatBytes(const size_t bytes);
+
+	// Heap memory allocated through the global operator new, counted by the hooks in Utils/AllocationHooks.h
+	// Memory allocated with malloc directly (like RapidJSON's default allocators) is only visible in the resident set size
+	struct AllocationCounters
+	{
+		size_t CurrentBytes = 0;
+		size_t PeakBytes = 0;
+		uint64_t AllocationCount = 0;
+		uint64_t DeallocationCount = 0;
+	};
+
+	// False if the executable does not install the hooks
+	bool IsAllocationTrackingEnabled();
+	AllocationCounters GetAllocationCounters();
+
+	void RecordAllocation(const size_t size);
+	void RecordDeallocation(const size_t size);
+
+	// Measures the allocations made between its construction and Stop, scopes can be nested and used from many threads
+	// The counters are process-wide, so allocations of other threads during the scope are included
+	// The outermost scopes of every thread are tracked to tell whether the result was shared with another thread's scope
+	class AllocationScope
+	{
+	public:
+		struct Result
+		{
+			size_t PeakBytes = 0; // Above the heap usage at the start of the scope
+			uint64_t AllocationCount = 0;
+			bool IsExclusive = false; // No scope of another thread overlapped it, unscoped threads still are not detected
+		};
+
+		// Scopes beyond it only see the heap usage at their end as their peak
+		static constexpr uint32_t MAX_ACTIVE_SCOPE_COUNT = 64;
+
+	public:
+		AllocationScope();
+		~AllocationScope();
+
+		AllocationScope(const AllocationScope&) = delete;
+		AllocationScope& operator=(const AllocationScope&) = delete;
+
+		// Can be called once, the destructor stops the scope otherwise
+		AllocationScope::Result Stop();
+
+	private:
+		size_t m_StartBytes;
+		uint64_t m_StartAllocationCount;
+		uint64_t m_StartScopeCount; // Outermost scopes started before it, including its own
+		uint32_t m_StartActiveThreadCount; // Threads in an outermost scope at its start, including its own
+		uint32_t m_SlotIndex; // MAX_ACTIVE_SCOPE_COUNT if no slot was free
+		bool m_IsStopped;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "corepch.h"
+#include "Utils/Profiler.h"
+
+#include "Utils/FileUtils.h"
+
+namespace utils
+{
+	/*static*/ Profiler& Profiler::Get()
+	{
+		static Profiler profiler;
+		return profiler;
+	}
+
+	Profiler::Profiler()
+		: m_IsEnabled(false)
+		, m_Start(std::chrono::steady_clock::now())
+		, m_NextEventIndex(0)
+	{
+	}
+
+	void Profiler::SetEnabled(const bool isEnabled)
+	{
+		m_IsEnabled.store(isEnabled, std::memory_order_relaxed);
+	}
+
+	void Profiler::AddEvent(const Profiler::Event& event)
+	{
+		std::lock_guard lock(m_EventsMtx);
+
+		if (m_Events.size() < MAX_EVENT_COUNT)
+			m_Events.push_back(event);
+		else
+			m_Events[m_NextEventIndex] = event;
+
+		m_NextEventIndex = (m_NextEventIndex + 1) % MAX_EVENT_COUNT;
+	}
+
+	std::vector<Profiler::Event> Profiler::GetEvents() const
+	{
+		std::lock_guard lock(m_EventsMtx);
+
+		if (m_Events.size() < MAX_EVENT_COUNT)
+			return m_Events;
+
+		// The buffer is full, so the oldest event is the one to be overwritten next
+		std::vector<Event> events;
+		events.reserve(m_Events.size());
+		events.insert(events.end(), m_Events.begin() + m_NextEventIndex, m_Events.end());
+		events.insert(events.end(), m_Events.begin(), m_Events.begin() + m_NextEventIndex);
+
+		return events;
+	}
+
+	void Profiler::Clear()
+	{
+		std::lock_guard lock(m_EventsMtx);
+
+		m_Events.clear();
+		m_NextEventIndex = 0;
+	}
+
+	bool Profiler::ExportChromeTrace(const fs::path& filepath) const
+	{
+		const auto events = GetEvents();
+
+		json::StringBuffer jsonStringBuffer;
+		json::Writer<json::StringBuffer> jsonWriter(jsonStringBuffer);
+
+		jsonWriter.StartObject();
+		jsonWriter.Key("displayTimeUnit");
+		jsonWriter.String("ms");
+		jsonWriter.Key("traceEvents");
+		jsonWriter.StartArray();
+		for (const auto& event : events)
+		{
+			// Complete events ("X") have both their start and their duration
+			jsonWriter.StartObject();
+			jsonWriter.Key("name");
+			jsonWriter.String(event.Name);
+			jsonWriter.Key("ph");
+			jsonWriter.String("X");
+			jsonWriter.Key("ts");
+			jsonWriter.Int64(event.Start);
+			jsonWriter.Key("dur");
+			jsonWriter.Int64(event.Duration);
+			jsonWriter.Key("pid");
+			jsonWriter.Uint(0);
+			jsonWriter.Key("tid");
+			jsonWriter.Uint(event.ThreadId);
+			jsonWriter.EndObject();
+		}
+		jsonWriter.EndArray();
+		jsonWriter.EndObject();
+
+		return WriteFile(filepath, jsonStringBuffer.GetString());
+	}
+
+	int64_t Profiler::GetTimestamp() const
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_Start).count();
+	}
+
+	/*static*/ uint32_t Profiler::GetThreadId()
+	{
+		// Small sequential ids read better in trace viewers than the native ones
+		static std::atomic<uint32_t> nextThreadId = 0;
+		thread_local const uint32_t threadId = nextThreadId++;
+
+		return threadId;
+	}
+
+	ProfileScope::ProfileScope(const char* const name)
+		: m_Name(Profiler::Get().IsEnabled() ? name : nullptr)
+		, m_Start(m_Name ? Profiler::Get().GetTimestamp() : 0)
+	{
+	}
+
+	ProfileScope::~ProfileScope()
+	{
+		if (!m_Name) return;
+
+		auto& profiler = Profiler::Get();
+		profiler.AddEvent({ m_Name, Profiler::GetThreadId(), m_Start, profiler.GetTimestamp() - m_Start });
+	}
+}
\ No newline at end of file
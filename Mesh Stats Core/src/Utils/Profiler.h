@@ -0,0 +1,68 @@
+#pragma once
+
+namespace utils
+{
+	// Collects the timed scopes of all threads into a bounded buffer, disabled by default
+	class Profiler
+	{
+	public:
+		struct Event
+		{
+			const char* Name; // Has to outlive the profiler, usually a string literal
+			uint32_t ThreadId;
+			int64_t Start; // Microseconds since the profiler was created
+			int64_t Duration; // Microseconds
+		};
+
+		// The oldest events are overwritten once the buffer is full
+		static constexpr size_t MAX_EVENT_COUNT = 1 << 18;
+
+	public:
+		static Profiler& Get();
+
+		bool IsEnabled() const;
+		void SetEnabled(const bool isEnabled);
+
+		void AddEvent(const Profiler::Event& event);
+		std::vector<Profiler::Event> GetEvents() const; // Oldest first
+		void Clear();
+
+		// Chrome trace event format, can be opened in chrome://tracing or Perfetto
+		bool ExportChromeTrace(const fs::path& filepath) const;
+
+		int64_t GetTimestamp() const;
+		static uint32_t GetThreadId();
+
+	private:
+		Profiler();
+
+	private:
+		std::atomic<bool> m_IsEnabled;
+		const std::chrono::steady_clock::time_point m_Start;
+
+		mutable std::mutex m_EventsMtx;
+		std::vector<Profiler::Event> m_Events;
+		size_t m_NextEventIndex;
+	};
+
+	// Records the time between its construction and destruction, does nothing if the profiler was disabled on construction
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(const char* const name);
+		~ProfileScope();
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* m_Name;
+		int64_t m_Start;
+	};
+
+	// Inline, so a disabled profiler costs a single relaxed load per scope
+	inline bool Profiler::IsEnabled() const
+	{
+		return m_IsEnabled.load(std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
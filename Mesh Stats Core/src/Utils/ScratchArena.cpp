@@ -0,0 +1,172 @@
+#include "corepch.h"
+#include "Utils/ScratchArena.h"
+
+namespace utils
+{
+	namespace
+	{
+		std::atomic<size_t> s_RetainedBytes = 0;
+
+		// Shared by all threads, the analyses run on threads started for each task and would lose thread-local blocks
+		std::mutex s_RetainedBlocksMutex;
+		std::vector<ScratchArena::RetainedBlock> s_RetainedBlocks;
+		size_t s_PooledBytes = 0; // Of s_RetainedBlocks, guarded by its mutex
+
+		thread_local ScratchArena* t_CurrentArena = nullptr;
+
+		// The biggest block of the pool, an empty one if there is none
+		ScratchArena::RetainedBlock TakeRetainedBlock()
+		{
+			std::scoped_lock lock(s_RetainedBlocksMutex);
+			if (s_RetainedBlocks.empty()) return {};
+
+			const auto biggestBlock = std::max_element(s_RetainedBlocks.begin(), s_RetainedBlocks.end(),
+				[](const ScratchArena::RetainedBlock& leftBlock, const ScratchArena::RetainedBlock& rightBlock) -> bool
+				{
+					return leftBlock.Size < rightBlock.Size;
+				}
+			);
+
+			ScratchArena::RetainedBlock block = std::move(*biggestBlock);
+			*biggestBlock = std::move(s_RetainedBlocks.back());
+			s_RetainedBlocks.pop_back();
+			s_PooledBytes -= block.Size;
+			return block;
+		}
+
+		void GiveBackRetainedBlock(ScratchArena::RetainedBlock&& block)
+		{
+			if (block.Size == 0) return;
+
+			// The smallest blocks are freed until the pool fits in its budget again, outside of the lock
+			std::vector<ScratchArena::RetainedBlock> freedBlocks;
+			{
+				std::scoped_lock lock(s_RetainedBlocksMutex);
+				s_PooledBytes += block.Size;
+				s_RetainedBlocks.push_back(std::move(block));
+
+				while (s_PooledBytes > ScratchArena::MAX_RETAINED_BYTES)
+				{
+					const auto smallestBlock = std::min_element(s_RetainedBlocks.begin(), s_RetainedBlocks.end(),
+						[](const ScratchArena::RetainedBlock& leftBlock, const ScratchArena::RetainedBlock& rightBlock) -> bool
+						{
+							return leftBlock.Size < rightBlock.Size;
+						}
+					);
+
+					s_PooledBytes -= smallestBlock->Size;
+					freedBlocks.push_back(std::move(*smallestBlock));
+					*smallestBlock = std::move(s_RetainedBlocks.back());
+					s_RetainedBlocks.pop_back();
+				}
+			}
+
+			for (const auto& freedBlock : freedBlocks)
+				s_RetainedBytes -= freedBlock.Size;
+		}
+	}
+
+	/*static*/ std::pmr::memory_resource* ScratchArena::GetCurrentResource()
+	{
+		return t_CurrentArena ? t_CurrentArena->GetResource() : std::pmr::get_default_resource();
+	}
+
+	/*static*/ size_t ScratchArena::GetRetainedBytes()
+	{
+		return s_RetainedBytes;
+	}
+
+	/*static*/ void ScratchArena::ReleaseRetained()
+	{
+		std::vector<ScratchArena::RetainedBlock> releasedBlocks;
+		{
+			std::scoped_lock lock(s_RetainedBlocksMutex);
+			releasedBlocks.swap(s_RetainedBlocks);
+			s_PooledBytes = 0;
+		}
+
+		for (const auto& block : releasedBlocks)
+			s_RetainedBytes -= block.Size;
+	}
+
+	ScratchArena::ScratchArena()
+		: m_PreviousArena(t_CurrentArena)
+		, m_RetainedBlock(TakeRetainedBlock())
+		, m_MonotonicResource(m_RetainedBlock.Data.get(), m_RetainedBlock.Size, &m_OverflowResource)
+		, m_PoolResource(&m_MonotonicResource)
+	{
+		t_CurrentArena = this;
+	}
+
+	ScratchArena::~ScratchArena()
+	{
+		m_PoolResource.release();
+		m_MonotonicResource.release();
+
+		t_CurrentArena = m_PreviousArena;
+
+		// The next operation as big as this one fits in the block
+		const size_t overflowBytes = m_OverflowResource.GetAllocatedBytes();
+		const size_t neededBytes = m_RetainedBlock.Size + overflowBytes;
+		if (overflowBytes > 0 && neededBytes <= MAX_RETAINED_BYTES)
+		{
+			s_RetainedBytes += neededBytes - m_RetainedBlock.Size;
+			m_RetainedBlock.Data.reset();
+			m_RetainedBlock.Data = std::make_unique_for_overwrite<std::byte[]>(neededBytes);
+			m_RetainedBlock.Size = neededBytes;
+		}
+
+		GiveBackRetainedBlock(std::move(m_RetainedBlock));
+	}
+
+	std::pmr::memory_resource* ScratchArena::GetResource()
+	{
+		return &m_PoolResource;
+	}
+
+	size_t ScratchArena::OverflowResource::GetAllocatedBytes() const
+	{
+		return m_AllocatedBytes;
+	}
+
+	void* ScratchArena::OverflowResource::do_allocate(const size_t bytes, const size_t alignment)
+	{
+		m_AllocatedBytes += bytes;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void ScratchArena::OverflowResource::do_deallocate(void* const pointer, const size_t bytes, const size_t alignment)
+	{
+		std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+	}
+
+	bool ScratchArena::OverflowResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		return this == &other;
+	}
+
+	/*static*/ void ScratchJsonAllocator::Free(void* const /*pointer*/)
+	{
+	}
+
+	ScratchJsonAllocator::ScratchJsonAllocator()
+		: m_Resource(ScratchArena::GetCurrentResource())
+	{
+	}
+
+	void* ScratchJsonAllocator::Malloc(const size_t size)
+	{
+		return size > 0 ? m_Resource->allocate(size, alignof(std::max_align_t)) : nullptr;
+	}
+
+	void* ScratchJsonAllocator::Realloc(void* const originalPointer, const size_t originalSize, const size_t newSize)
+	{
+		if (newSize <= originalSize && originalPointer) return originalPointer;
+
+		void* const newPointer = Malloc(newSize);
+		if (originalPointer && newPointer)
+			std::memcpy(newPointer, originalPointer, originalSize);
+
+		return newPointer;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+namespace utils
+{
+	// Memory for the transient containers of one operation (hash maps, their nodes, temporary vectors), freed all at once
+	// when the arena is destroyed. Blocks freed during the operation are reused by a pool, which takes its memory from
+	// a monotonic buffer. The buffer starts in a block taken from a process-wide pool and given back grown to what the
+	// operation needed, so repeated operations make almost no heap allocations, even when they run on threads started
+	// for them (the tasks of the analyses). The pool keeps at most MAX_RETAINED_BYTES in total, freeing its smallest blocks
+	// Not thread-safe, every thread of a parallel operation uses its own arena
+	class ScratchArena
+	{
+	public:
+		static constexpr size_t MAX_RETAINED_BYTES = 64 << 20; // Of all the blocks in the pool
+
+		// Of the innermost arena of the calling thread, the default memory resource if there is none
+		static std::pmr::memory_resource* GetCurrentResource();
+
+		// Kept by the pool between operations, and by the arenas using its blocks
+		static size_t GetRetainedBytes();
+
+		// Frees the blocks in the pool, the ones in use are given back when their arenas are destroyed
+		// Called once a batch of operations is done, so their blocks do not outlive them
+		static void ReleaseRetained();
+
+		// Of the pool, held by an arena while it is used
+		struct RetainedBlock
+		{
+			std::unique_ptr<std::byte[]> Data;
+			size_t Size = 0;
+		};
+
+	public:
+		ScratchArena();
+		~ScratchArena();
+
+		ScratchArena(const ScratchArena&) = delete;
+		ScratchArena& operator=(const ScratchArena&) = delete;
+
+		std::pmr::memory_resource* GetResource();
+
+	private:
+		// Counts what the monotonic buffer takes from the heap once the kept block is used up
+		class OverflowResource : public std::pmr::memory_resource
+		{
+		public:
+			size_t GetAllocatedBytes() const;
+
+		private:
+			void* do_allocate(const size_t bytes, const size_t alignment) override;
+			void do_deallocate(void* const pointer, const size_t bytes, const size_t alignment) override;
+			bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		private:
+			size_t m_AllocatedBytes = 0;
+		};
+
+	private:
+		ScratchArena* m_PreviousArena;
+		ScratchArena::RetainedBlock m_RetainedBlock;
+
+		OverflowResource m_OverflowResource;
+		std::pmr::monotonic_buffer_resource m_MonotonicResource;
+		std::pmr::unsynchronized_pool_resource m_PoolResource;
+	};
+
+	// RapidJSON allocator over the current scratch arena of the thread that creates it
+	// Nothing is freed before the arena is destroyed, as RapidJSON frees through a static function
+	class ScratchJsonAllocator
+	{
+	public:
+		static const bool kNeedFree = false;
+
+		static void Free(void* const pointer);
+
+	public:
+		ScratchJsonAllocator();
+
+		void* Malloc(const size_t size);
+		void* Realloc(void* const originalPointer, const size_t originalSize, const size_t newSize);
+
+	private:
+		std::pmr::memory_resource* m_Resource;
+	};
+
+	// Its values and parsing stack live in the scratch arena current when it is created, which has to outlive it
+	using ScratchJsonDocument = json::GenericDocument<json::UTF8<>, json::MemoryPoolAllocator<ScratchJsonAllocator>, ScratchJsonAllocator>;
+	using ScratchJsonValue = ScratchJsonDocument::ValueType;
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#pragma once
+
+namespace utils
+{
+	// Immutable elements held in reference-counted chunks. Copies share the chunks, and Append makes an array that shares
+	// all of them and only allocates the new elements, so arrays extending one another cost about as much as the longest
+	// Reads like a const std::vector, an index is looked up from the last chunk, which holds most elements when appending grows the array
+	template<typename T>
+	class SharedChunkedArray
+	{
+	public:
+		SharedChunkedArray() = default;
+		explicit SharedChunkedArray(std::vector<T>&& elements); // Adopted as the only chunk, without copying
+
+		// The elements of this array followed by the new ones
+		SharedChunkedArray Append(std::vector<T>&& elements) const;
+
+		size_t size() const;
+		size_t GetChunkCount() const;
+		std::span<const T> GetChunk(const size_t chunkIndex) const;
+
+		const T& operator[](const size_t index) const;
+		const T* data() const; // Null if the elements are split over several chunks
+
+		size_t GetMemoryUsage() const; // Bytes, of every chunk
+		size_t GetSharedMemoryUsage() const; // Bytes, of the chunks also held by other arrays
+
+	private:
+		struct Chunk
+		{
+			const T* Data = nullptr;
+			size_t FirstIndex = 0;
+			std::shared_ptr<const std::vector<T>> Elements;
+		};
+
+	private:
+		std::vector<Chunk> m_Chunks;
+		size_t m_Size = 0;
+	};
+
+	template<typename T>
+	SharedChunkedArray<T>::SharedChunkedArray(std::vector<T>&& elements)
+	{
+		if (elements.empty()) return;
+
+		auto chunkElements = std::make_shared<const std::vector<T>>(std::move(elements));
+		m_Size = chunkElements->size();
+		m_Chunks.push_back({ chunkElements->data(), 0, std::move(chunkElements) });
+	}
+
+	template<typename T>
+	SharedChunkedArray<T> SharedChunkedArray<T>::Append(std::vector<T>&& elements) const
+	{
+		SharedChunkedArray array = *this;
+		if (elements.empty()) return array;
+
+		elements.shrink_to_fit();
+		auto chunkElements = std::make_shared<const std::vector<T>>(std::move(elements));
+		array.m_Size += chunkElements->size();
+		array.m_Chunks.push_back({ chunkElements->data(), m_Size, std::move(chunkElements) });
+
+		return array;
+	}
+
+	template<typename T>
+	size_t SharedChunkedArray<T>::size() const
+	{
+		return m_Size;
+	}
+
+	template<typename T>
+	size_t SharedChunkedArray<T>::GetChunkCount() const
+	{
+		return m_Chunks.size();
+	}
+
+	template<typename T>
+	std::span<const T> SharedChunkedArray<T>::GetChunk(const size_t chunkIndex) const
+	{
+		return *m_Chunks[chunkIndex].Elements;
+	}
+
+	template<typename T>
+	const T& SharedChunkedArray<T>::operator[](const size_t index) const
+	{
+		ASSERT(index < m_Size);
+
+		size_t chunkIndex = m_Chunks.size() - 1;
+		while (index < m_Chunks[chunkIndex].FirstIndex)
+			--chunkIndex;
+
+		const auto& chunk = m_Chunks[chunkIndex];
+		return chunk.Data[index - chunk.FirstIndex];
+	}
+
+	template<typename T>
+	const T* SharedChunkedArray<T>::data() const
+	{
+		return m_Chunks.size() == 1 ? m_Chunks.front().Data : nullptr;
+	}
+
+	template<typename T>
+	size_t SharedChunkedArray<T>::GetMemoryUsage() const
+	{
+		size_t memoryUsage = 0;
+		for (const auto& chunk : m_Chunks)
+			memoryUsage += chunk.Elements->capacity() * sizeof(T);
+
+		return memoryUsage;
+	}
+
+	template<typename T>
+	size_t SharedChunkedArray<T>::GetSharedMemoryUsage() const
+	{
+		size_t memoryUsage = 0;
+		for (const auto& chunk : m_Chunks)
+		{
+			if (chunk.Elements.use_count() > 1)
+				memoryUsage += chunk.Elements->capacity() * sizeof(T);
+		}
+
+		return memoryUsage;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "corepch.h"
+#include "Utils/TaskGraph.h"
+
+namespace utils
+{
+	TaskGraph::~TaskGraph()
+	{
+		for (const auto& task : m_Tasks)
+		{
+			if (task->IsStarted && task->Thread.valid())
+				task->Thread.wait();
+		}
+	}
+
+	TaskGraph::TaskId TaskGraph::Add(std::function<void()>&& function)
+	{
+		return Add(std::move(function), {});
+	}
+
+	TaskGraph::TaskId TaskGraph::Add(std::function<void()>&& function, const std::vector<TaskGraph::TaskId>& dependencies)
+	{
+		auto task = std::make_unique<Task>();
+		task->Function = std::move(function);
+		task->Dependencies = dependencies;
+		task->Future = task->Promise.get_future().share();
+
+		for (const TaskId dependency : dependencies)
+			ASSERT(dependency < m_Tasks.size());
+
+		m_Tasks.push_back(std::move(task));
+		return static_cast<TaskId>(m_Tasks.size() - 1);
+	}
+
+	TaskGraph::TaskId TaskGraph::AddDone()
+	{
+		const TaskId task = Add({});
+		m_Tasks[task]->Promise.set_value();
+		return task;
+	}
+
+	size_t TaskGraph::GetTaskCount() const
+	{
+		return m_Tasks.size();
+	}
+
+	void TaskGraph::Start(const TaskGraph::TaskId taskId)
+	{
+		auto& task = *m_Tasks[taskId];
+		std::call_once(task.StartOnceFlag,
+			[this, &task]() -> void
+			{
+				if (!task.Function)
+				{
+					task.IsStarted = true;
+					return;
+				}
+
+				// The dependencies start first, so every future waited for below is bound to be set
+				std::vector<std::shared_future<void>> dependencyFutures;
+				dependencyFutures.reserve(task.Dependencies.size());
+				for (const TaskId dependency : task.Dependencies)
+				{
+					Start(dependency);
+					dependencyFutures.push_back(m_Tasks[dependency]->Future);
+				}
+
+				task.Thread = std::async(std::launch::async,
+					[&task, dependencyFutures = std::move(dependencyFutures)]() mutable -> void
+					{
+						try
+						{
+							// Rethrows the exception of a failed dependency, which then fails this task too
+							for (const auto& dependencyFuture : dependencyFutures)
+								dependencyFuture.get();
+
+							dependencyFutures.clear();
+
+							task.Function();
+							task.Function = nullptr;
+							task.Promise.set_value();
+						}
+						catch (...)
+						{
+							task.Function = nullptr;
+							task.IsFailed = true;
+							task.Promise.set_exception(std::current_exception());
+						}
+					}
+				);
+
+				task.IsStarted = true;
+			}
+		);
+	}
+
+	std::shared_future<void> TaskGraph::GetFuture(const TaskGraph::TaskId task)
+	{
+		Start(task);
+		return m_Tasks[task]->Future;
+	}
+
+	void TaskGraph::Wait(const TaskGraph::TaskId task)
+	{
+		Start(task);
+		m_Tasks[task]->Future.get();
+	}
+
+	bool TaskGraph::IsStarted(const TaskGraph::TaskId task) const
+	{
+		return m_Tasks[task]->IsStarted;
+	}
+
+	bool TaskGraph::IsDone(const TaskGraph::TaskId task) const
+	{
+		return m_Tasks[task]->Future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+
+	bool TaskGraph::IsFailed(const TaskGraph::TaskId task) const
+	{
+		return m_Tasks[task]->IsFailed;
+	}
+}
\ No newline at end of file
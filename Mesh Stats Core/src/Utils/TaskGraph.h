@@ -0,0 +1,56 @@
+#pragma once
+
+namespace utils
+{
+	// Tasks that run each on its own thread once started, as soon as the tasks they depend on are done, so independent
+	// tasks run concurrently. Nothing runs before it is started, directly or through a task depending on it, so a graph
+	// can describe work that may never be needed
+	// Destroying the graph waits for the started tasks, which can then safely use whatever is destroyed after it
+	class TaskGraph
+	{
+	public:
+		using TaskId = uint32_t;
+
+	public:
+		TaskGraph() = default;
+		~TaskGraph();
+
+		TaskGraph(const TaskGraph&) = delete;
+		TaskGraph& operator=(const TaskGraph&) = delete;
+
+		// Not thread-safe, every task is added before any is started. The dependencies have to be tasks of this graph
+		// The function, with what it captures, is released as soon as it has run
+		TaskGraph::TaskId Add(std::function<void()>&& function);
+		TaskGraph::TaskId Add(std::function<void()>&& function, const std::vector<TaskGraph::TaskId>& dependencies);
+		TaskGraph::TaskId AddDone(); // For work done before the graph was made, which other tasks can still depend on
+
+		size_t GetTaskCount() const;
+
+		// Thread-safe, start the task and the tasks it depends on unless they already are
+		void Start(const TaskGraph::TaskId task);
+		std::shared_future<void> GetFuture(const TaskGraph::TaskId task);
+		void Wait(const TaskGraph::TaskId task); // Rethrows the exception of the task, or of a dependency it failed with
+
+		bool IsStarted(const TaskGraph::TaskId task) const;
+		bool IsDone(const TaskGraph::TaskId task) const; // Whether it succeeded or failed
+		bool IsFailed(const TaskGraph::TaskId task) const; // It, or a dependency, threw
+
+	private:
+		struct Task
+		{
+			std::function<void()> Function;
+			std::vector<TaskGraph::TaskId> Dependencies;
+
+			std::promise<void> Promise;
+			std::shared_future<void> Future;
+
+			std::once_flag StartOnceFlag;
+			std::atomic<bool> IsStarted = false;
+			std::atomic<bool> IsFailed = false;
+			std::future<void> Thread;
+		};
+
+	private:
+		std::vector<std::unique_ptr<TaskGraph::Task>> m_Tasks;
+	};
+}
\ No newline at end of file
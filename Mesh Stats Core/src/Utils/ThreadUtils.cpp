@@ -0,0 +1,184 @@
+#include "corepch.h"
+#include "Utils/ThreadUtils.h"
+
+namespace utils
+{
+	namespace
+	{
+		// Threads shared by the parallel loops, started once instead of for every loop
+		class WorkerPool
+		{
+		public:
+			explicit WorkerPool(const uint32_t threadCount)
+			{
+				m_Threads.reserve(threadCount);
+				for (uint32_t i = 0; i < threadCount; ++i)
+					m_Threads.emplace_back(&WorkerPool::Run, this);
+			}
+
+			~WorkerPool()
+			{
+				{
+					std::scoped_lock lock(m_Mutex);
+					m_IsStopping = true;
+				}
+
+				m_Condition.notify_all();
+				for (auto& thread : m_Threads)
+					thread.join();
+			}
+
+			uint32_t GetThreadCount() const
+			{
+				return static_cast<uint32_t>(m_Threads.size());
+			}
+
+			void Submit(std::function<void()>&& job)
+			{
+				{
+					std::scoped_lock lock(m_Mutex);
+					m_Jobs.push_back(std::move(job));
+				}
+
+				m_Condition.notify_one();
+			}
+
+		private:
+			// The queued jobs are still run when stopping, they only find their loop done
+			void Run()
+			{
+				while (true)
+				{
+					std::function<void()> job;
+					{
+						std::unique_lock lock(m_Mutex);
+						m_Condition.wait(lock,
+							[this]() -> bool
+							{
+								return m_IsStopping || !m_Jobs.empty();
+							}
+						);
+
+						if (m_Jobs.empty()) return;
+
+						job = std::move(m_Jobs.front());
+						m_Jobs.pop_front();
+					}
+
+					job();
+				}
+			}
+
+		private:
+			std::mutex m_Mutex;
+			std::condition_variable m_Condition;
+			std::deque<std::function<void()>> m_Jobs;
+			bool m_IsStopping = false;
+
+			std::vector<std::thread> m_Threads;
+		};
+
+		WorkerPool& GetWorkerPool()
+		{
+			// The calling thread of a loop works too
+			static WorkerPool workerPool(GetThreadCount() - 1);
+			return workerPool;
+		}
+
+		// Shared with the helpers of a loop, which may only start once it is done and then find no index left
+		struct LoopState
+		{
+			std::atomic<size_t> NextIndex = 0;
+			std::atomic<size_t> CompletedCount = 0;
+
+			std::atomic<bool> IsFailed = false;
+			std::mutex ExceptionMutex;
+			std::exception_ptr Exception; // The first one thrown
+		};
+
+		// The calling thread takes indexes until none is left, then waits for the ones taken by the helpers
+		// An exception fails the loop, the remaining indexes are skipped and it is rethrown on the calling thread
+		void RunLoop(const size_t count, const uint32_t threadCount, const std::function<void(size_t index)>& function)
+		{
+			auto state = std::make_shared<LoopState>();
+			const auto processItems = [state, count, &function]() -> void
+				{
+					for (size_t index = state->NextIndex++; index < count; index = state->NextIndex++)
+					{
+						// The function is only called while the calling thread waits for the index to complete
+						if (!state->IsFailed.load(std::memory_order_relaxed))
+						{
+							try
+							{
+								function(index);
+							}
+							catch (...)
+							{
+								std::scoped_lock lock(state->ExceptionMutex);
+								if (!state->Exception)
+									state->Exception = std::current_exception();
+
+								state->IsFailed = true;
+							}
+						}
+
+						if (++state->CompletedCount == count)
+							state->CompletedCount.notify_all();
+					}
+				};
+
+			const uint32_t helperCount = std::min(threadCount - 1, GetWorkerPool().GetThreadCount());
+			for (uint32_t i = 0; i < helperCount; ++i)
+				GetWorkerPool().Submit(processItems);
+
+			processItems();
+
+			for (size_t completedCount = state->CompletedCount.load(); completedCount < count; completedCount = state->CompletedCount.load())
+				state->CompletedCount.wait(completedCount);
+
+			if (state->Exception)
+				std::rethrow_exception(state->Exception);
+		}
+	}
+
+	uint32_t GetThreadCount()
+	{
+		const uint32_t hardwareConcurrency = std::thread::hardware_concurrency();
+		return hardwareConcurrency > 0 ? hardwareConcurrency : 4;
+	}
+
+	void ParallelFor(const size_t count, const std::function<void(size_t startIndex, size_t endIndex)>& function)
+	{
+		if (count == 0) return;
+
+		const size_t chunkCount = std::min<size_t>(count, GetThreadCount());
+		if (chunkCount == 1)
+		{
+			function(0, count);
+			return;
+		}
+
+		RunLoop(chunkCount, static_cast<uint32_t>(chunkCount),
+			[count, chunkCount, &function](const size_t chunkIndex) -> void
+			{
+				function(count * chunkIndex / chunkCount, count * (chunkIndex + 1) / chunkCount);
+			}
+		);
+	}
+
+	void ParallelForEach(const size_t count, const uint32_t threadCount, const std::function<void(size_t index)>& function)
+	{
+		if (count == 0) return;
+
+		const size_t usedThreadsCount = std::clamp<size_t>(threadCount, 1, count);
+		if (usedThreadsCount == 1)
+		{
+			for (size_t index = 0; index < count; ++index)
+				function(index);
+
+			return;
+		}
+
+		RunLoop(count, static_cast<uint32_t>(usedThreadsCount), function);
+	}
+}
\ No newline at end of file
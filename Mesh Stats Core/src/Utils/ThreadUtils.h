@@ -0,0 +1,77 @@
+#pragma once
+
+namespace utils
+{
+	uint32_t GetThreadCount();
+
+	// The loops below run on the calling thread and the threads of a shared pool, one less than GetThreadCount
+	// An exception thrown by the function skips the remaining items and is rethrown once the other threads are done
+
+	// Splits [0, count) into contiguous chunks, one per thread
+	void ParallelFor(const size_t count, const std::function<void(size_t startIndex, size_t endIndex)>& function);
+
+	// Each thread takes the next unprocessed index, which balances items of very different costs
+	// At most as many threads as GetThreadCount work together, pool threads busy with other loops join once free
+	void ParallelForEach(const size_t count, const uint32_t threadCount, const std::function<void(size_t index)>& function);
+
+	// Sorts one chunk per core, then merges neighbouring chunks in parallel until a single one is left
+	template<typename T, typename Compare = std::less<>>
+	void ParallelSort(std::span<T> values, Compare compare = Compare());
+
+	// Merges neighbouring sorted runs in parallel until a single one is left
+	// The run starts are followed by the end of the values, so there is one more of them than there are runs
+	template<typename T, typename Compare = std::less<>>
+	void ParallelMerge(std::span<T> values, std::span<const size_t> runStarts, Compare compare = Compare());
+
+	template<typename T, typename Compare>
+	void ParallelSort(std::span<T> values, Compare compare /* = Compare()*/)
+	{
+		static constexpr size_t MIN_CHUNK_SIZE = 1 << 14;
+
+		const size_t chunkCount = std::min<size_t>(GetThreadCount(), values.size() / MIN_CHUNK_SIZE);
+		if (chunkCount <= 1)
+		{
+			std::sort(values.begin(), values.end(), compare);
+			return;
+		}
+
+		std::vector<size_t> chunkStarts(chunkCount + 1);
+		for (size_t i = 0; i <= chunkCount; ++i)
+			chunkStarts[i] = values.size() * i / chunkCount;
+
+		ParallelForEach(chunkCount, static_cast<uint32_t>(chunkCount),
+			[&](const size_t chunkIndex) -> void
+			{
+				std::sort(values.begin() + chunkStarts[chunkIndex], values.begin() + chunkStarts[chunkIndex + 1], compare);
+			}
+		);
+
+		ParallelMerge(values, std::span<const size_t>(chunkStarts), compare);
+	}
+
+	template<typename T, typename Compare>
+	void ParallelMerge(std::span<T> values, std::span<const size_t> runStarts, Compare compare /* = Compare()*/)
+	{
+		ASSERT(!runStarts.empty() && runStarts.back() == values.size());
+
+		const size_t runCount = runStarts.size() - 1;
+		for (size_t width = 1; width < runCount; width *= 2)
+		{
+			const size_t mergeCount = (runCount + 2 * width - 1) / (2 * width);
+			ParallelForEach(mergeCount, std::min<uint32_t>(static_cast<uint32_t>(mergeCount), GetThreadCount()),
+				[&](const size_t mergeIndex) -> void
+				{
+					const size_t firstRun = mergeIndex * 2 * width;
+					const size_t middleRun = std::min(firstRun + width, runCount);
+					const size_t lastRun = std::min(firstRun + 2 * width, runCount);
+
+					if (middleRun < lastRun)
+					{
+						std::inplace_merge(values.begin() + runStarts[firstRun], values.begin() + runStarts[middleRun],
+							values.begin() + runStarts[lastRun], compare);
+					}
+				}
+			);
+		}
+	}
+}
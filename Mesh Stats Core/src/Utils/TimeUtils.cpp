@@ -0,0 +1,87 @@
+#include "corepch.h"
+#include "Utils/TimeUtils.h"
+
+#ifdef _MSC_VER
+#	define LOCALTIME(_Tm, _Time) localtime_s(_Tm, _Time)
+#else
+#	define LOCALTIME(_Tm, _Time) localtime_r(_Time, _Tm)
+#endif
+
+namespace
+{
+	tm GetTimeInfo(const time_t rawTime)
+	{
+		tm timeInfo;
+		LOCALTIME(&timeInfo, &rawTime);
+
+		return timeInfo;
+	}
+
+	tm GetTimeInfo()
+	{
+		time_t rawTime;
+		time(&rawTime);
+
+		return GetTimeInfo(rawTime);
+	}
+}
+
+namespace utils
+{
+	std::string GetDate()
+	{
+		const auto timeInfo = GetTimeInfo();
+
+		std::ostringstream stringStream;
+		stringStream << std::put_time(&timeInfo, "%d/%m/%Y");
+		return stringStream.str();
+	}
+
+	std::string GetTime()
+	{
+		const auto timeInfo = GetTimeInfo();
+
+		std::ostringstream stringStream;
+		stringStream << std::put_time(&timeInfo, "%T");
+		return stringStream.str();
+	}
+
+	std::string GetTime(const std::chrono::system_clock::time_point timePoint)
+	{
+		const auto timeInfo = GetTimeInfo(std::chrono::system_clock::to_time_t(timePoint));
+		const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(timePoint.time_since_epoch()).count() % 1000;
+
+		std::ostringstream stringStream;
+		stringStream << std::put_time(&timeInfo, "%T") << '.' << std::setfill('0') << std::setw(3) << milliseconds;
+		return stringStream.str();
+	}
+
+	std::string GetDateTime()
+	{
+		const auto timeInfo = GetTimeInfo();
+
+		std::ostringstream stringStream;
+		stringStream << std::put_time(&timeInfo, "%d/%m/%Y %T");
+		return stringStream.str();
+	}
+
+	Timer::Timer()
+		: m_Start(std::chrono::steady_clock::now())
+	{
+	}
+
+	void Timer::Reset()
+	{
+		m_Start = std::chrono::steady_clock::now();
+	}
+
+	double Timer::GetElapsedMilliseconds() const
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Start).count();
+	}
+
+	double Timer::GetElapsedSeconds() const
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace utils
+{
+	std::string GetDate();
+	std::string GetTime();
+	std::string GetTime(const std::chrono::system_clock::time_point timePoint); // With milliseconds
+	std::string GetDateTime();
+
+	class Timer
+	{
+	public:
+		Timer();
+
+		void Reset();
+		double GetElapsedMilliseconds() const;
+		double GetElapsedSeconds() const;
+
+	private:
+		std::chrono::steady_clock::time_point m_Start;
+	};
+}
\ No newline at end of file
@@ -0,0 +1 @@
+#include "corepch.h"
\ No newline at end of file
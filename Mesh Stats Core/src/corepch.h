@@ -0,0 +1,63 @@
+#pragma once
+
+// Precompiled header of the core library, without any windowing or UI dependencies
+
+// C++ Libraries
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <format>
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+
+#include <array>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <chrono>
+#include <limits>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <bit>
+#include <span>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include <filesystem>
+
+// RapidJSON
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+// Mesh Stats Core
+#include "Macros/Assert.h"
+
+// Namespaces
+namespace fs = std::filesystem;
+namespace json = rapidjson;
+
+// Logging and profiling, after the namespaces they use
+#include "Macros/Log.h"
+#include "Macros/Profile.h"
\ No newline at end of file
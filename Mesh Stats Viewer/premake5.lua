@@ -21,6 +21,8 @@ project "Mesh Stats Viewer"
     {
         "src",
         "vendor",
+        "%{SourceDirs.Core}",
+        "%{VendorDirs.Core}",
         "%{IncludeDirs.GLFW}"
     }
 
@@ -31,6 +33,7 @@ project "Mesh Stats Viewer"
 
     links
     {
+        "Mesh Stats Core",
         "glfw3_mt",
         "opengl32"
     }
@@ -1,17 +1,28 @@
 #include "pch.h"
 #include "Application/Application.h"
 
+#include "Application/ElementTable.h"
+#include "Application/MemoryPanel.h"
 #include "Application/Notification.h"
+#include "Application/ProfilerPanel.h"
 #include "Application/Window.h"
 #include "Core/Mesh.h"
-#include "Utils/FileUtils.h"
+#include "Core/PointsFile.h"
+#include "Utils/FileDialogUtils.h"
+#include "Utils/ScratchArena.h"
+#include "Utils/TimeUtils.h"
 
 namespace
 {
 	constexpr const char* WINDOW_SETTINGS_PATH = R"(config\window_settings.json)";
+	constexpr const char* LOG_FILE_PATH = "Mesh Stats Viewer.log"; // The release build has no console
+
+	// Longest time the window sleeps without events, the shorter one while a job reports its progress
+	constexpr double IDLE_TIMEOUT_SECONDS = 1.0;
+	constexpr double JOB_IDLE_TIMEOUT_SECONDS = 0.1;
 
 	constexpr uint32_t TEXT_BOX_VISIBLE_ENTRIES = 4;
-	constexpr uint32_t MAIN_WINDOW_HEIGHT_MULTIPLIER = TEXT_BOX_VISIBLE_ENTRIES + 10;
+	constexpr uint32_t MAIN_WINDOW_HEIGHT_MULTIPLIER = TEXT_BOX_VISIBLE_ENTRIES + 15;
 
 	constexpr ImVec4 COLOR_RED = { 1.f, 0.f, 0.f, 1.f };
 	constexpr ImVec4 COLOR_GREEN = { 0.f, 1.f, 0.f, 1.f };
@@ -24,6 +35,10 @@ namespace
 	constexpr const char* SAVE_AS_FILE_DIALOG_NAME = "Save As";
 	constexpr const char* SAVE_AS_FILE_DIALOG_DEFAULT_PATH = R"(res\meshes\mesh.json)";
 
+	constexpr const char* OPEN_POINTS_FILE_DIALOG_NAME = "Open Points";
+	constexpr const char* SAVE_RESULTS_FILE_DIALOG_NAME = "Save Results As";
+	constexpr const char* SAVE_RESULTS_FILE_DIALOG_DEFAULT_PATH = "results.json";
+
 	const std::vector<std::string> FILE_DIALOG_FILTERS = { "JSON (*.json)", "*.json" };
 
 	void WriteBool(const char* const name, const bool value)
@@ -45,13 +60,13 @@ namespace
 		ImGui::PopStyleColor();
 	}
 
-	void WriteUint(const char* const name, const uint32_t value)
+	void WriteUint(const char* const name, const uint64_t value)
 	{
 		ImGui::Text("%s:", name);
 		ImGui::SameLine();
 
 		ImGui::PushStyleColor(ImGuiCol_Text, COLOR_YELLOW);
-		ImGui::Text("%u", value);
+		ImGui::Text("%llu", static_cast<unsigned long long>(value));
 		ImGui::PopStyleColor();
 	}
 
@@ -65,6 +80,39 @@ namespace
 		ImGui::PopStyleColor();
 	}
 
+	// For the results of an analysis still running in the background
+	void WriteCalculating(const char* const name)
+	{
+		ImGui::Text("%s:", name);
+		ImGui::SameLine();
+		ImGui::TextDisabled("calculating...");
+	}
+
+	// For the results of an analysis whose computation threw
+	void WriteFailed(const char* const name)
+	{
+		ImGui::Text("%s:", name);
+		ImGui::SameLine();
+
+		ImGui::PushStyleColor(ImGuiCol_Text, COLOR_RED);
+		ImGui::TextUnformatted("failed");
+		ImGui::PopStyleColor();
+	}
+
+	// For an estimate of the results of an analysis still running in the background
+	void WriteApproximate(const char* const name, const std::string& value)
+	{
+		ImGui::Text("%s:", name);
+		ImGui::SameLine();
+
+		ImGui::PushStyleColor(ImGuiCol_Text, COLOR_YELLOW);
+		ImGui::Text("%s", value.c_str());
+		ImGui::PopStyleColor();
+
+		ImGui::SameLine();
+		ImGui::TextDisabled("approximate");
+	}
+
 	void AddSeparator()
 	{
 		ImGui::Spacing();
@@ -78,23 +126,34 @@ namespace
 	}
 }
 
-/*static*/ void Application::Start(const int argc, const char* const* const argv)
+// The commands run in the Mesh Stats CLI, the release build of the viewer has no console to print their output to
+/*static*/ int Application::Start(const int argc, const char* const* const argv)
 {
 	Application app;
 	app.Run();
+	return EXIT_SUCCESS;
 }
 
 Application::Application()
 	: m_Mesh(nullptr)
 	, m_Window(nullptr)
-	, m_IsCheckButtonClicked(false)
-	, m_IsPointInsideMesh(false)
+	, m_VerticesTable(std::make_unique<ElementTable>("Vertices"))
+	, m_TrianglesTable(std::make_unique<ElementTable>("Triangles"))
+	, m_SmoothVertexNormalsTable(std::make_unique<ElementTable>("SmoothVertexNormals"))
+	, m_ProfilerPanel(std::make_unique<ProfilerPanel>())
+	, m_IsProfilerOpen(false)
+	, m_MemoryPanel(std::make_unique<MemoryPanel>())
+	, m_IsMemoryPanelOpen(false)
+	, m_ClassificationGridResolution(ClassificationGrid::DEFAULT_RESOLUTION)
 {
 	Init();
 }
 
 void Application::Init()
 {
+	if (!utils::Logger::Get().SetFile(LOG_FILE_PATH))
+		std::cerr << std::format("Could not open log file: \"{}\"", LOG_FILE_PATH) << std::endl;
+
 	const auto windowSettings = Window::Settings::LoadFromFile(WINDOW_SETTINGS_PATH);
 	ASSERT(windowSettings);
 
@@ -108,6 +167,8 @@ void Application::Run()
 
 	while (m_Window->IsRunning())
 	{
+		PROFILE_SCOPE("Application::Frame");
+
 		const float framebufferWidth = static_cast<float>(m_Window->GetFramebufferWidth());
 		const float framebufferHeight = static_cast<float>(m_Window->GetFramebufferHeight());
 
@@ -119,11 +180,22 @@ void Application::Run()
 		const ImVec2 notificationsWindowPos = { 0.f, mainWindowPos.y + mainWindowSize.y };
 		const ImVec2 notificationsWindowSize = { framebufferWidth, framebufferHeight - mainMenuBarHeight - mainWindowSize.y };
 
-		m_Window->Update();
+		const auto currentMesh = m_Mesh.load();
+		const bool isJobRunning = m_LoadResult.valid() || m_SubdivisionResult.valid() || m_PointCheckResult.valid() ||
+			!m_BackgroundJobs.empty() || !m_RetiredMeshes.empty() || (currentMesh && !currentMesh->IsAnalyzed());
+		m_Window->Update(isJobRunning ? JOB_IDLE_TIMEOUT_SECONDS : IDLE_TIMEOUT_SECONDS);
+		UpdateLoadJob();
+		UpdateSubdivisionJob();
+		UpdatePointCheckJob();
+		UpdateBackgroundJobs();
+		ReleaseRetiredMeshes();
 		m_Window->StartFrame();
 
-		DisplayMainMenuBar();
-		HandleShortcuts();
+		// The whole frame displays this snapshot, even if a mesh opened from the menu replaces it meanwhile
+		const auto mesh = m_Mesh.load();
+
+		DisplayMainMenuBar(mesh != nullptr);
+		HandleShortcuts(mesh != nullptr);
 
 		{
 			ImGui::PushStyleColor(ImGuiCol_WindowBg, { 0.f, 0.f, 0.f, 0.f });
@@ -134,13 +206,13 @@ void Application::Run()
 				ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoTitleBar
 			);
 
-			if (m_Mesh)
+			if (mesh)
 			{
-				DisplayMeshDataSection();
+				DisplayMeshDataSection(*mesh);
 				AddSeparator();
 				DisplaySubdivideMeshSection();
 				AddSeparator();
-				DisplayIsPointInsideMeshSection();
+				DisplayIsPointInsideMeshSection(*mesh);
 			}
 			else
 			{
@@ -164,20 +236,56 @@ void Application::Run()
 			ImGui::End();
 		}
 
+		if (m_IsProfilerOpen)
+		{
+			if (auto notification = m_ProfilerPanel->Display(m_IsProfilerOpen))
+				AddNotification(std::move(*notification));
+		}
+
+		if (m_IsMemoryPanelOpen)
+			m_MemoryPanel->Display(m_IsMemoryPanelOpen, mesh.get());
+
+		// The text cursor blinks while typing
+		if (ImGui::GetIO().WantTextInput)
+			m_Window->RequestFrames();
+
 		m_Window->Render();
 	}
+
+	CancelSubdivisionJob();
+
+	// Lets running loads, checks and exports finish, the futures of std::async wait for their jobs when destroyed
+	m_LoadResult = {};
+	m_PointCheckResult = {};
+	m_BackgroundJobs.clear();
+	m_RetiredMeshes.clear();
+
+	utils::Logger::Get().Flush();
 }
 
-void Application::DisplayMainMenuBar()
+void Application::DisplayMainMenuBar(const bool hasMesh)
 {
 	ASSERT(ImGui::BeginMainMenuBar());
 
 	if (ImGui::BeginMenu("File"))
 	{
-		if (ImGui::MenuItem("Open...", "Ctrl+O"))
+		if (ImGui::MenuItem("Open...", "Ctrl+O", false, !m_LoadResult.valid()))
 			OpenMeshFile();
 
-		if (m_Mesh)
+		ImGui::MenuItem("Reorder on Open", nullptr, &m_LoadOptions.ReorderForLocality);
+
+		if (ImGui::BeginMenu("Vertex Storage on Open"))
+		{
+			for (const auto encoding : { PositionBuffer::Encoding::Float, PositionBuffer::Encoding::Quantized21, PositionBuffer::Encoding::Quantized16 })
+			{
+				if (ImGui::MenuItem(PositionBuffer::GetEncodingName(encoding), nullptr, encoding == m_LoadOptions.VertexEncoding))
+					m_LoadOptions.VertexEncoding = encoding;
+			}
+
+			ImGui::EndMenu();
+		}
+
+		if (hasMesh)
 		{
 			if (ImGui::MenuItem("Save As...", "Ctrl+S"))
 				SaveMeshToFile();
@@ -186,25 +294,43 @@ void Application::DisplayMainMenuBar()
 		ImGui::EndMenu();
 	}
 
+	if (ImGui::BeginMenu("View"))
+	{
+		ImGui::MenuItem("Profiler", nullptr, &m_IsProfilerOpen);
+		ImGui::MenuItem("Memory", nullptr, &m_IsMemoryPanelOpen);
+
+		if (ImGui::BeginMenu("Log Level"))
+		{
+			const auto currentLevel = utils::Logger::GetLevel();
+			for (const auto level : { utils::LogLevel::Info, utils::LogLevel::Warning, utils::LogLevel::Error, utils::LogLevel::None })
+			{
+				if (ImGui::MenuItem(utils::Logger::GetLevelName(level), nullptr, level == currentLevel))
+					utils::Logger::SetLevel(level);
+			}
+
+			ImGui::EndMenu();
+		}
+
+		ImGui::EndMenu();
+	}
+
 	ImGui::EndMainMenuBar();
 }
 
-void Application::HandleShortcuts()
+void Application::HandleShortcuts(const bool hasMesh)
 {
 	if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_O, ImGuiInputFlags_RouteGlobal))
 		OpenMeshFile();
 
-	if (m_Mesh)
+	if (hasMesh)
 	{
 		if (ImGui::Shortcut(ImGuiMod_Ctrl | ImGuiKey_S, ImGuiInputFlags_RouteGlobal))
 			SaveMeshToFile();
 	}
 }
 
-void Application::DisplayMeshDataSection()
+void Application::DisplayMeshDataSection(const Mesh& mesh)
 {
-	ASSERT(m_Mesh);
-
 	const auto& style = ImGui::GetStyle();
 	const float windowWidth = ImGui::GetWindowSize().x;
 	const float itemSpacingWidth = style.ItemSpacing.x;
@@ -212,10 +338,12 @@ void Application::DisplayMeshDataSection()
 	
 	const float textboxWidth = (windowWidth - 2.f * itemSpacingWidth - windowPaddingWidth) / 3.f;
 
+	// Each analysis is displayed as soon as it is done, the others keep running in the background
+	const bool areSmoothVertexNormalsReady = mesh.IsReady(Mesh::Attribute::SmoothVertexNormals);
+
 	{
-		const auto vertexCount = static_cast<uint32_t>(m_Mesh->GetVertices().size());
-		const auto trianglesCount = static_cast<uint32_t>(m_Mesh->GetTriangles().size());
-		const auto smoothVertexNormalsCount = static_cast<uint32_t>(m_Mesh->GetSmoothVertexNormals().size());
+		const uint64_t vertexCount = mesh.GetVertices().GetCount();
+		const uint64_t trianglesCount = mesh.GetTriangles().GetCount();
 
 		WriteUint("Vertices", vertexCount);
 		ImGui::SameLine();
@@ -223,65 +351,225 @@ void Application::DisplayMeshDataSection()
 		WriteUint("Triangles", trianglesCount);
 		ImGui::SameLine();
 		ImGui::SetCursorPosX(windowPaddingWidth + 2.f * (textboxWidth + itemSpacingWidth));
-		WriteUint("Smooth vertex normals", smoothVertexNormalsCount);
+		if (areSmoothVertexNormalsReady)
+			WriteUint("Smooth vertex normals", mesh.GetSmoothVertexNormals().GetCount());
+		else if (mesh.IsFailed(Mesh::Attribute::SmoothVertexNormals))
+			WriteFailed("Smooth vertex normals");
+		else
+			WriteCalculating("Smooth vertex normals");
 	}
 
 	{
-		const float textboxHeight = 2.f * style.FramePadding.y + ImGui::GetTextLineHeight() * TEXT_BOX_VISIBLE_ENTRIES;
-		const ImVec2 textboxSize = { textboxWidth, textboxHeight };
+		const float tableHeight = 2.f * style.FramePadding.y + ImGui::GetTextLineHeightWithSpacing() * TEXT_BOX_VISIBLE_ENTRIES;
+		const ImVec2 tableSize = { textboxWidth, tableHeight };
+
+		const auto& vertices = mesh.GetVertices();
+		const auto& triangles = mesh.GetTriangles();
+		static const NormalBuffer NO_NORMALS;
+		const auto& smoothVertexNormals = areSmoothVertexNormalsReady ? mesh.GetSmoothVertexNormals() : NO_NORMALS;
+
+		const auto notifyCopied = [this](const std::optional<size_t> copiedRowCount, const char* const elementsName) -> void
+			{
+				if (copiedRowCount)
+					AddNotification(Notification::Info(std::format("Copied {} {} to the clipboard", *copiedRowCount, elementsName)));
+			};
 
-		ImGui::InputTextMultiline("##Vertices", m_VerticesText.data(), m_VerticesText.size() + 1, textboxSize, ImGuiInputTextFlags_ReadOnly);
+		notifyCopied(m_VerticesTable->Display(tableSize, vertices.GetCount(),
+			[&vertices](const size_t index) -> std::string { return ToString(vertices.Get(index)); }), "vertices");
 		ImGui::SameLine();
-		ImGui::InputTextMultiline("##Triangles", m_TrianglesText.data(), m_TrianglesText.size() + 1, textboxSize, ImGuiInputTextFlags_ReadOnly);
+		notifyCopied(m_TrianglesTable->Display(tableSize, triangles.GetCount(),
+			[&triangles](const size_t index) -> std::string
+			{
+				const auto vertexIndexes = triangles.GetVertexIndexes(index);
+				return std::format("({}, {}, {})", vertexIndexes[0], vertexIndexes[1], vertexIndexes[2]);
+			}), "triangles");
 		ImGui::SameLine();
-		ImGui::InputTextMultiline("##SmoothVertexNormals", m_SmoothVertexNormalsText.data(), m_SmoothVertexNormalsText.size() + 1, textboxSize, ImGuiInputTextFlags_ReadOnly);
+		notifyCopied(m_SmoothVertexNormalsTable->Display(tableSize, smoothVertexNormals.GetCount(),
+			[&smoothVertexNormals](const size_t index) -> std::string { return ToString(smoothVertexNormals.Get(index)); }), "smooth vertex normals");
 	}
 
 	AddSeparator();
 
+	if (mesh.IsReady(Mesh::Attribute::Statistics))
 	{
-		const auto& statistics = m_Mesh->GetStatistics();
-		const uint32_t edgeCount = m_Mesh->GetEdgeCount();
-		const bool isClosed = m_Mesh->IsClosed();
+		const auto& statistics = mesh.GetStatistics();
 
 		WriteFloat("Smallest triangle area", statistics.SmallestTriangleArea);
 		WriteFloat("Biggest triangle area", statistics.BiggestTriangleArea);
 		WriteFloat("Average triangle area", statistics.AverageTriangleArea);
-		WriteUint("Edge count", edgeCount);
-		WriteBool("Is closed", isClosed);
+	}
+	else if (mesh.IsFailed(Mesh::Attribute::Statistics))
+	{
+		WriteFailed("Smallest triangle area");
+		WriteFailed("Biggest triangle area");
+		WriteFailed("Average triangle area");
+	}
+	else if (const auto estimate = mesh.GetStatisticsEstimate())
+	{
+		// The sampled extremes only bound the exact ones
+		const auto& statistics = estimate->Statistics;
+
+		WriteApproximate("Smallest triangle area", std::format("<= {:f}", statistics.SmallestTriangleArea));
+		WriteApproximate("Biggest triangle area", std::format(">= {:f}", statistics.BiggestTriangleArea));
+		WriteApproximate("Average triangle area", std::format("{:f} +/- {:f}", statistics.AverageTriangleArea, estimate->AverageTriangleAreaMargin));
+	}
+	else
+	{
+		WriteCalculating("Smallest triangle area");
+		WriteCalculating("Biggest triangle area");
+		WriteCalculating("Average triangle area");
+	}
+
+	if (mesh.IsReady(Mesh::Attribute::Edges))
+	{
+		WriteUint("Edge count", mesh.GetEdgeCount());
+		WriteBool("Is closed", mesh.IsClosed());
+	}
+	else if (mesh.IsFailed(Mesh::Attribute::Edges))
+	{
+		WriteFailed("Edge count");
+		WriteFailed("Is closed");
+	}
+	else
+	{
+		WriteCalculating("Edge count");
+		WriteCalculating("Is closed");
 	}
 }
 
 void Application::DisplaySubdivideMeshSection()
 {
+	if (m_SubdivisionResult.valid())
+	{
+		static constexpr float PROGRESS_BAR_WIDTH_MULTIPLIER = 12.f;
+
+		const bool isCanceled = m_SubdivisionProgress->IsCanceled();
+		const auto progressText = isCanceled
+			? std::string("Canceling...")
+			: std::format("{} ({}/{})", m_SubdivisionProgress->GetStageName(),
+				m_SubdivisionProgress->GetStageIndex() + 1, m_SubdivisionProgress->GetStageCount());
+
+		ImGui::TextUnformatted("Generating subdivided mesh:");
+		ImGui::SameLine();
+		ImGui::ProgressBar(m_SubdivisionProgress->GetProgress(), { ImGui::GetFrameHeight() * PROGRESS_BAR_WIDTH_MULTIPLIER, 0.f }, progressText.c_str());
+		ImGui::SameLine();
+
+		ImGui::BeginDisabled(isCanceled);
+		if (ImGui::Button("Cancel"))
+			m_SubdivisionProgress->Cancel();
+		ImGui::EndDisabled();
+
+		return;
+	}
+
 	ImGui::TextUnformatted("Generate a new mesh by subdividing each triangle into 4 smaller ones:");
 	ImGui::SameLine();
 	if (ImGui::Button("Generate Mesh"))
-	{
-		AssignMesh(m_Mesh->GenerateSubdividedMesh());
-		AddNotification(Notification::Info("Generated new subdivided mesh"));
-	}
+		StartSubdivisionJob();
 }
 
-void Application::DisplayIsPointInsideMeshSection()
+void Application::DisplayIsPointInsideMeshSection(const Mesh& mesh)
 {
 	ImGui::TextUnformatted("Point:");
 	ImGui::SameLine();
 	ImGui::InputFloat3("##Point", &m_Point.x);
 
+	{
+		static constexpr const char* INSIDE_TEST_MODE_NAMES[] = { "Ray parity", "Winding number" };
+		static constexpr float MIN_WINDING_NUMBER_ACCURACY = 1.f;
+		static constexpr float MAX_WINDING_NUMBER_ACCURACY = 8.f;
+
+		int mode = static_cast<int>(m_InsideTestOptions.Mode);
+
+		ImGui::TextUnformatted("Inside test:");
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(ImGui::CalcTextSize(INSIDE_TEST_MODE_NAMES[1]).x + ImGui::GetFrameHeightWithSpacing() * 2.f);
+		if (ImGui::Combo("##InsideTestMode", &mode, INSIDE_TEST_MODE_NAMES, IM_ARRAYSIZE(INSIDE_TEST_MODE_NAMES)))
+			m_InsideTestOptions.Mode = static_cast<Mesh::InsideTestMode>(mode);
+
+		if (m_InsideTestOptions.Mode == Mesh::InsideTestMode::WindingNumber)
+		{
+			ImGui::SameLine();
+			ImGui::TextUnformatted("Accuracy:");
+			ImGui::SameLine();
+			ImGui::SliderFloat("##WindingNumberAccuracy", &m_InsideTestOptions.WindingNumberAccuracy,
+				MIN_WINDING_NUMBER_ACCURACY, MAX_WINDING_NUMBER_ACCURACY, "%.1f");
+		}
+	}
+
+	{
+		static constexpr int MIN_CLASSIFICATION_GRID_RESOLUTION = 16;
+		static constexpr int MAX_CLASSIFICATION_GRID_RESOLUTION = 512;
+
+		ImGui::TextUnformatted("Classification grid:");
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(ImGui::GetFrameHeightWithSpacing() * 6.f);
+		ImGui::SliderInt("##ClassificationGridResolution", &m_ClassificationGridResolution,
+			MIN_CLASSIFICATION_GRID_RESOLUTION, MAX_CLASSIFICATION_GRID_RESOLUTION);
+		ImGui::SameLine();
+		if (ImGui::Button("Build Grid"))
+		{
+			// The grid is stored in the snapshot, which shows it once it is built
+			StartBackgroundJob(
+				[mesh = m_Mesh.load(), resolution = static_cast<uint32_t>(m_ClassificationGridResolution)]() -> std::vector<Notification>
+				{
+					std::vector<Notification> notifications;
+
+					const auto grid = mesh->BuildClassificationGrid(resolution);
+					notifications.push_back(Notification::Info(std::format("Built classification grid in {:.3f} ms", grid->GetBuildTime())));
+
+					if (!mesh->IsClosed())
+						notifications.push_back(Notification::Warning("The mesh is not closed, the classification grid will not be used"));
+
+					return notifications;
+				}
+			);
+		}
+
+		if (const auto grid = mesh.GetClassificationGrid())
+		{
+			ImGui::SameLine();
+			if (ImGui::Button("Clear Grid"))
+				mesh.ClearClassificationGrid();
+
+			const auto& cellCounts = grid->GetCellCounts();
+			const float boundaryPercentage = 100.f * grid->GetCellCount(ClassificationGrid::CellState::Boundary) / grid->GetCellCount();
+
+			ImGui::SameLine();
+			ImGui::Text("%ux%ux%u cells, %.2f MB, %.1f%% boundary", cellCounts[0], cellCounts[1], cellCounts[2],
+				grid->GetMemoryUsage() / (1024.f * 1024.f), boundaryPercentage);
+		}
+	}
+
 	ImGui::TextUnformatted("Check if point is inside mesh:");
 	ImGui::SameLine();
+	ImGui::BeginDisabled(m_PointCheckResult.valid());
 	if (ImGui::Button("Check"))
+		StartPointCheckJob();
+	ImGui::EndDisabled();
+
+	if (m_PointCheckResult.valid())
 	{
-		m_IsCheckButtonClicked = true;
-		m_IsPointInsideMesh = m_Mesh->IsPointInsideMesh(m_Point);
-		AddNotification(Notification::Info(std::format("Checked if point {} is inside mesh", ToString(m_Point))));
+		WriteCalculating("Is point inside mesh");
+		WriteCalculating("Signed distance");
+	}
+	else if (m_PointCheck)
+	{
+		WriteBool("Is point inside mesh", m_PointCheck->IsInside);
+		WriteFloat("Signed distance", m_PointCheck->SignedDistance);
+		ImGui::SameLine();
+		ImGui::Text("Closest point: %s", ToString(m_PointCheck->ClosestPoint).c_str());
 	}
-
-	if (m_IsCheckButtonClicked)
-		WriteBool("Is point inside mesh", m_IsPointInsideMesh);
 	else
+	{
 		ImGui::TextUnformatted("Is point inside mesh:");
+		ImGui::TextUnformatted("Signed distance:");
+	}
+
+	ImGui::TextUnformatted("Check which points from a file are inside mesh:");
+	ImGui::SameLine();
+	if (ImGui::Button("Open Points..."))
+		CheckPointsFromFile();
 }
 
 void Application::DisplayNoMeshLoadedScreen()
@@ -346,94 +634,294 @@ void Application::AddNotification(Notification&& notification)
 
 void Application::AssignMesh(Mesh&& mesh)
 {
-	static constexpr size_t STRING_INITIAL_CAPACITY_VECTOR3F = 35;
-	static constexpr size_t STRING_INITIAL_CAPACITY_TRIANGLE = 25;
-
-	m_Mesh = std::make_unique<Mesh>(std::move(mesh));
-
-	const auto& vertices = m_Mesh->GetVertices();
-	const auto& triangles = m_Mesh->GetTriangles();
-	const auto& smoothVertexNormals = m_Mesh->GetSmoothVertexNormals();
+	// A running subdivision of the previous mesh would replace this one when done
+	if (m_SubdivisionResult.valid())
+		m_SubdivisionProgress->Cancel();
+
+	// The mesh is shown right away, its analyses are displayed as they finish
+	mesh.Prefetch();
+	if (auto previousMesh = m_Mesh.exchange(std::make_shared<const Mesh>(std::move(mesh))))
+		m_RetiredMeshes.push_back(std::move(previousMesh));
+
+	// The tables format their rows on demand, so only their scroll and input state has to be reset
+	m_VerticesTable->Reset();
+	m_TrianglesTable->Reset();
+	m_SmoothVertexNormalsTable->Reset();
+}
 
-	auto verticesTextFuture = std::async(std::launch::async,
-		[&vertices]() -> std::string
+void Application::ReleaseRetiredMeshes()
+{
+	// Once only this reference is left, as the frame and the jobs reading a snapshot may still hold theirs
+	for (auto it = m_RetiredMeshes.begin(); it != m_RetiredMeshes.end();)
+	{
+		if (it->use_count() > 1)
 		{
-			std::string result;
-			result.reserve(vertices.size() * STRING_INITIAL_CAPACITY_VECTOR3F);
+			++it;
+			continue;
+		}
 
-			for (const auto& vertex : vertices)
+		StartBackgroundJob(
+			[mesh = std::move(*it)]() mutable -> std::vector<Notification>
 			{
-				result += ToString(vertex);
-				result += '\n';
+				mesh.reset();
+
+				// The blocks sized for the previous mesh's operations, the current one fills the pool again as needed
+				utils::ScratchArena::ReleaseRetained();
+				return {};
 			}
+		);
+
+		it = m_RetiredMeshes.erase(it);
+	}
+}
 
-			return result.erase(result.size() - 1); // Remove the last new line
+void Application::StartLoadJob(const fs::path& filepath)
+{
+	ASSERT(!m_LoadResult.valid());
+
+	// The current mesh stays displayed and queryable until the loaded one replaces it
+	m_LoadFilepath = filepath;
+	m_LoadResult = std::async(std::launch::async,
+		[filepath, options = m_LoadOptions]() -> std::optional<Mesh>
+		{
+			auto mesh = Mesh::LoadFromFile(filepath, options);
+			Window::PostEmptyEvent();
+
+			return mesh;
 		}
 	);
 
-	auto trianglesTextFuture = std::async(std::launch::async,
-		[&triangles]() -> std::string
-		{
-			std::string result;
-			result.reserve(triangles.size() * STRING_INITIAL_CAPACITY_TRIANGLE);
+	AddNotification(Notification::Info(std::format("Loading mesh from: \"{}\"", filepath.string())));
+}
 
-			for (const auto& triangle : triangles)
-			{
-				result += std::format("({}, {}, {})",
-					triangle.VertexIndexes[0], triangle.VertexIndexes[1], triangle.VertexIndexes[2]);
-				result += '\n';
-			}
+void Application::UpdateLoadJob()
+{
+	if (!m_LoadResult.valid() || m_LoadResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
 
-			return result.erase(result.size() - 1); // Remove the last new line
+	if (auto mesh = m_LoadResult.get())
+	{
+		AssignMesh(std::move(*mesh));
+		AddNotification(Notification::Info(std::format("Successfully loaded mesh from: \"{}\"", m_LoadFilepath.string())));
+	}
+	else
+	{
+		AddNotification(Notification::Error(std::format("File does not exist or has incorrect format: \"{}\"", m_LoadFilepath.string())));
+	}
+}
+
+void Application::StartSubdivisionJob()
+{
+	ASSERT(m_Mesh.load() && !m_SubdivisionResult.valid());
+
+	m_SubdivisionProgress = std::make_shared<utils::JobProgress>(Mesh::SUBDIVISION_STAGE_COUNT);
+
+	// The job keeps its own reference to the mesh, which stays displayed and queryable until the result is assigned
+	m_SubdivisionResult = std::async(std::launch::async,
+		[mesh = m_Mesh.load(), progress = m_SubdivisionProgress]() -> std::optional<Mesh>
+		{
+			auto subdividedMesh = mesh->GenerateSubdividedMesh(*progress);
+			Window::PostEmptyEvent();
+
+			return subdividedMesh;
 		}
 	);
+}
+
+void Application::UpdateSubdivisionJob()
+{
+	if (!m_SubdivisionResult.valid() || m_SubdivisionResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+
+	// The analyses of the mesh it reads rethrow their exceptions
+	std::optional<Mesh> subdividedMesh;
+	try
+	{
+		subdividedMesh = m_SubdivisionResult.get();
+	}
+	catch (const std::exception& exception)
+	{
+		AddNotification(Notification::Error(std::format("Could not generate the subdivided mesh: {}", exception.what())));
+		m_SubdivisionProgress.reset();
+		return;
+	}
+
+	if (subdividedMesh && !m_SubdivisionProgress->IsCanceled())
+	{
+		AssignMesh(std::move(*subdividedMesh));
+		AddNotification(Notification::Info("Generated new subdivided mesh"));
+	}
+	else
+	{
+		AddNotification(Notification::Warning("Canceled generating the subdivided mesh"));
+	}
+
+	m_SubdivisionProgress.reset();
+}
+
+void Application::CancelSubdivisionJob()
+{
+	if (!m_SubdivisionResult.valid())
+		return;
+
+	m_SubdivisionProgress->Cancel();
+	m_SubdivisionResult.wait();
+	m_SubdivisionResult = {};
+	m_SubdivisionProgress.reset();
+}
+
+void Application::StartPointCheckJob()
+{
+	ASSERT(m_Mesh.load() && !m_PointCheckResult.valid());
 
-	auto smoothVertexNormalsTextFuture = std::async(std::launch::async,
-		[&smoothVertexNormals]() -> std::string
+	// The first check of a mesh waits for its BVH, which takes seconds on big meshes
+	m_PointCheckResult = std::async(std::launch::async,
+		[mesh = m_Mesh.load(), point = m_Point, options = m_InsideTestOptions]() -> Application::PointCheck
 		{
-			std::string result;
-			result.reserve(smoothVertexNormals.size() * STRING_INITIAL_CAPACITY_VECTOR3F);
+			PROFILE_SCOPE("Application::CheckPoint");
+
+			const utils::Timer timer;
+
+			PointCheck pointCheck;
+			pointCheck.Point = point;
+			pointCheck.IsInside = mesh->IsPointInsideMesh(point, options);
+			pointCheck.SignedDistance = mesh->SignedDistance(point, options);
+			pointCheck.ClosestPoint = mesh->ClosestPoint(point);
+			pointCheck.Milliseconds = timer.GetElapsedMilliseconds();
+
+			Window::PostEmptyEvent();
+			return pointCheck;
+		}
+	);
+}
+
+void Application::UpdatePointCheckJob()
+{
+	if (!m_PointCheckResult.valid() || m_PointCheckResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return;
+
+	// The analyses of the mesh it reads rethrow their exceptions
+	try
+	{
+		m_PointCheck = m_PointCheckResult.get();
+		AddNotification(Notification::Info(std::format("Checked if point {} is inside mesh in {:.3f} ms",
+			ToString(m_PointCheck->Point), m_PointCheck->Milliseconds)));
+	}
+	catch (const std::exception& exception)
+	{
+		AddNotification(Notification::Error(std::format("Could not check the point: {}", exception.what())));
+	}
+}
 
-			for (const auto& smoothVertexNormal : smoothVertexNormals)
+void Application::StartBackgroundJob(std::function<std::vector<Notification>()>&& job)
+{
+	m_BackgroundJobs.push_back(std::async(std::launch::async,
+		[job = std::move(job)]() -> std::vector<Notification>
+		{
+			// The analyses the job reads rethrow their exceptions, which are reported like the job's own errors
+			std::vector<Notification> notifications;
+			try
+			{
+				notifications = job();
+			}
+			catch (const std::exception& exception)
 			{
-				result += ToString(smoothVertexNormal);
-				result += '\n';
+				notifications.push_back(Notification::Error(std::format("Background job failed: {}", exception.what())));
 			}
 
-			return result.erase(result.size() - 1); // Remove the last new line
+			Window::PostEmptyEvent();
+			return notifications;
 		}
-	);
+	));
+}
 
-	m_VerticesText = verticesTextFuture.get();
-	m_TrianglesText = trianglesTextFuture.get();
-	m_SmoothVertexNormalsText = smoothVertexNormalsTextFuture.get();
+void Application::UpdateBackgroundJobs()
+{
+	for (auto it = m_BackgroundJobs.begin(); it != m_BackgroundJobs.end();)
+	{
+		if (it->wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			++it;
+			continue;
+		}
+
+		for (auto& notification : it->get())
+			AddNotification(std::move(notification));
+
+		it = m_BackgroundJobs.erase(it);
+	}
 }
 
 void Application::OpenMeshFile()
 {
+	// One mesh is loaded at a time, the shortcut and the button of the empty screen are ignored meanwhile
+	if (m_LoadResult.valid()) return;
+
 	const auto filepath = utils::OpenFileDialog(OPEN_FILE_DIALOG_NAME, OPEN_FILE_DIALOG_DEFAULT_PATH, FILE_DIALOG_FILTERS);
 	if (!filepath) return;
 
-	if (auto mesh = Mesh::LoadFromFile(*filepath))
-	{
-		AssignMesh(std::move(*mesh));
-		AddNotification(Notification::Info(std::format("Successfully loaded mesh from: \"{}\"", filepath->string())));
-	}
-	else
-	{
-		AddNotification(Notification::Error(std::format("File does not exist or has incorrect format: \"{}\"", filepath->string())));
-	}
+	StartLoadJob(*filepath);
 }
 
 void Application::SaveMeshToFile()
 {
-	ASSERT(m_Mesh);
+	ASSERT(m_Mesh.load());
 
 	const auto filepath = utils::SaveAsFileDialog(SAVE_AS_FILE_DIALOG_NAME, SAVE_AS_FILE_DIALOG_DEFAULT_PATH, FILE_DIALOG_FILTERS);
 	if (!filepath) return;
 
-	if (Mesh::SaveToFile(*filepath, *m_Mesh))
-		AddNotification(Notification::Info(std::format("Successfully saved mesh to: \"{}\"", filepath->string())));
-	else
-		AddNotification(Notification::Error(std::format("Could not save mesh to: \"{}\"", filepath->string())));
+	// Saves the mesh shown now, even if another one is opened before it is done
+	StartBackgroundJob(
+		[mesh = m_Mesh.load(), filepath = *filepath]() -> std::vector<Notification>
+		{
+			std::vector<Notification> notifications;
+			if (Mesh::SaveToFile(filepath, *mesh))
+				notifications.push_back(Notification::Info(std::format("Successfully saved mesh to: \"{}\"", filepath.string())));
+			else
+				notifications.push_back(Notification::Error(std::format("Could not save mesh to: \"{}\"", filepath.string())));
+
+			return notifications;
+		}
+	);
+}
+
+void Application::CheckPointsFromFile()
+{
+	ASSERT(m_Mesh.load());
+
+	const auto pointsFilepath = utils::OpenFileDialog(OPEN_POINTS_FILE_DIALOG_NAME, "", FILE_DIALOG_FILTERS);
+	if (!pointsFilepath) return;
+
+	// Asked before the check starts, which then runs in the background, the results are not saved if none is chosen
+	const auto resultsFilepath = utils::SaveAsFileDialog(SAVE_RESULTS_FILE_DIALOG_NAME, SAVE_RESULTS_FILE_DIALOG_DEFAULT_PATH, FILE_DIALOG_FILTERS);
+
+	StartBackgroundJob(
+		[mesh = m_Mesh.load(), pointsFilepath = *pointsFilepath, resultsFilepath, options = m_InsideTestOptions]() -> std::vector<Notification>
+		{
+			std::vector<Notification> notifications;
+
+			const auto points = PointsFile::LoadPoints(pointsFilepath);
+			if (!points)
+			{
+				notifications.push_back(Notification::Error(std::format("File does not exist or has incorrect format: \"{}\"", pointsFilepath.string())));
+				return notifications;
+			}
+
+			const utils::Timer timer;
+			const auto arePointsInside = mesh->ArePointsInsideMesh(*points, options);
+			const double elapsedSeconds = timer.GetElapsedSeconds();
+
+			notifications.push_back(Notification::Info(std::format("Checked {} points in {:.3f} ms ({:.0f} queries/s), {} inside mesh",
+				points->size(), elapsedSeconds * 1000.0, points->size() / elapsedSeconds, arePointsInside.Count())));
+
+			if (!resultsFilepath) return notifications;
+
+			if (PointsFile::SaveResults(*resultsFilepath, arePointsInside))
+				notifications.push_back(Notification::Info(std::format("Successfully saved results to: \"{}\"", resultsFilepath->string())));
+			else
+				notifications.push_back(Notification::Error(std::format("Could not save results to: \"{}\"", resultsFilepath->string())));
+
+			return notifications;
+		}
+	);
 }
\ No newline at end of file
@@ -1,30 +1,43 @@
 #pragma once
 
+#include "Core/Mesh.h"
 #include "Math/Vector3.h"
 
+class ElementTable;
+class MemoryPanel;
+class ProfilerPanel;
 class Window;
-class Mesh;
 struct Notification;
 
 class Application
 {
 public:
-	static void Start(const int argc, const char* const* const argv);
+	static int Start(const int argc, const char* const* const argv);
 
 public:
 	Application();
 
 	void Run();
 
+private:
+	struct PointCheck
+	{
+		Vector3f Point;
+		bool IsInside = false;
+		float SignedDistance = 0.f;
+		Vector3f ClosestPoint;
+		double Milliseconds = 0.0;
+	};
+
 private:
 	void Init();
 
-	void DisplayMainMenuBar();
-	void HandleShortcuts();
+	void DisplayMainMenuBar(const bool hasMesh);
+	void HandleShortcuts(const bool hasMesh);
 
-	void DisplayMeshDataSection();
+	void DisplayMeshDataSection(const Mesh& mesh);
 	void DisplaySubdivideMeshSection();
-	void DisplayIsPointInsideMeshSection();
+	void DisplayIsPointInsideMeshSection(const Mesh& mesh);
 
 	void DisplayNoMeshLoadedScreen();
 
@@ -33,20 +46,59 @@ private:
 
 	void AssignMesh(Mesh&& mesh);
 
+	// Destroying a snapshot waits for the tasks of its mesh, so the last reference is dropped by a background job
+	void ReleaseRetiredMeshes();
+
+	void StartLoadJob(const fs::path& filepath);
+	void UpdateLoadJob();
+
+	void StartSubdivisionJob();
+	void UpdateSubdivisionJob();
+	void CancelSubdivisionJob();
+
+	void StartPointCheckJob();
+	void UpdatePointCheckJob();
+
+	// Runs the job on its own thread, its notifications are shown once it is done
+	void StartBackgroundJob(std::function<std::vector<Notification>()>&& job);
+	void UpdateBackgroundJobs();
+
 	void OpenMeshFile();
 	void SaveMeshToFile();
+	void CheckPointsFromFile();
 
 private:
 	std::unique_ptr<Window> m_Window;
-	std::unique_ptr<Mesh> m_Mesh;
+
+	// Snapshot replaced as a whole by the UI thread, every frame and background job reads the one current when it starts
+	std::atomic<std::shared_ptr<const Mesh>> m_Mesh;
+	std::vector<std::shared_ptr<const Mesh>> m_RetiredMeshes; // Replaced, until nothing else references them
+
+	fs::path m_LoadFilepath;
+	std::future<std::optional<Mesh>> m_LoadResult;
+
+	std::shared_ptr<utils::JobProgress> m_SubdivisionProgress;
+	std::future<std::optional<Mesh>> m_SubdivisionResult;
+
+	std::vector<std::future<std::vector<Notification>>> m_BackgroundJobs;
 
 	std::vector<Notification> m_Notifications;
 
-	std::string m_VerticesText;
-	std::string m_TrianglesText;
-	std::string m_SmoothVertexNormalsText;
+	Mesh::LoadOptions m_LoadOptions;
+
+	std::unique_ptr<ElementTable> m_VerticesTable;
+	std::unique_ptr<ElementTable> m_TrianglesTable;
+	std::unique_ptr<ElementTable> m_SmoothVertexNormalsTable;
+
+	std::unique_ptr<ProfilerPanel> m_ProfilerPanel;
+	bool m_IsProfilerOpen;
+
+	std::unique_ptr<MemoryPanel> m_MemoryPanel;
+	bool m_IsMemoryPanelOpen;
 
-	bool m_IsCheckButtonClicked;
-	bool m_IsPointInsideMesh;
 	Vector3f m_Point;
+	std::optional<Application::PointCheck> m_PointCheck; // The last one done
+	std::future<Application::PointCheck> m_PointCheckResult;
+	Mesh::InsideTestOptions m_InsideTestOptions;
+	int m_ClassificationGridResolution;
 };
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "pch.h"
+#include "Application/ElementTable.h"
+
+namespace
+{
+	constexpr ImVec4 COLOR_HIGHLIGHT = { 1.f, 0.65f, 0.f, 0.35f };
+}
+
+ElementTable::ElementTable(const char* const id)
+	: m_Id(id)
+	, m_JumpToIndex(0)
+	, m_IsJumpRequested(false)
+	, m_CopyRange{ 0, 0 }
+{
+}
+
+std::optional<size_t> ElementTable::Display(const ImVec2& size, const size_t rowCount, const ElementTable::RowFormatter& formatRow)
+{
+	ImGui::PushID(m_Id.c_str());
+	ImGui::BeginGroup();
+
+	DisplayRows(size, rowCount, formatRow);
+	const auto copiedRowCount = DisplayControls(size.x, rowCount, formatRow);
+
+	ImGui::EndGroup();
+	ImGui::PopID();
+
+	return copiedRowCount;
+}
+
+void ElementTable::Reset()
+{
+	m_JumpToIndex = 0;
+	m_IsJumpRequested = false;
+	m_HighlightedIndex.reset();
+	m_CopyRange[0] = m_CopyRange[1] = 0;
+}
+
+void ElementTable::DisplayRows(const ImVec2& size, const size_t rowCount, const ElementTable::RowFormatter& formatRow)
+{
+	static constexpr ImGuiTableFlags TABLE_FLAGS = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_SizingFixedFit;
+
+	if (!ImGui::BeginTable("##Rows", 2, TABLE_FLAGS, size))
+		return;
+
+	ImGui::TableSetupColumn("Index", ImGuiTableColumnFlags_WidthFixed);
+	ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthStretch);
+
+	const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+	if (m_IsJumpRequested)
+	{
+		ImGui::SetScrollY(*m_HighlightedIndex * rowHeight);
+		m_IsJumpRequested = false;
+	}
+
+	// ImGui addresses the rows with ints, which is enough for about 2 billion elements
+	const int clippedRowCount = static_cast<int>(std::min<size_t>(rowCount, std::numeric_limits<int>::max()));
+
+	ImGuiListClipper clipper;
+	clipper.Begin(clippedRowCount, rowHeight);
+	while (clipper.Step())
+	{
+		for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+		{
+			const size_t index = static_cast<size_t>(row);
+
+			ImGui::TableNextRow();
+			if (m_HighlightedIndex == index)
+				ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg1, ImGui::GetColorU32(COLOR_HIGHLIGHT));
+
+			ImGui::TableNextColumn();
+			ImGui::TextDisabled("%zu", index);
+
+			ImGui::TableNextColumn();
+			const auto text = formatRow(index);
+			ImGui::TextUnformatted(text.data(), text.data() + text.size());
+		}
+	}
+
+	ImGui::EndTable();
+}
+
+std::optional<size_t> ElementTable::DisplayControls(const float width, const size_t rowCount, const ElementTable::RowFormatter& formatRow)
+{
+	const auto& style = ImGui::GetStyle();
+	const int lastIndex = static_cast<int>(std::min<size_t>(std::max<size_t>(rowCount, 1), std::numeric_limits<int>::max())) - 1;
+
+	const float goButtonWidth = ImGui::CalcTextSize("Go").x + 2.f * style.FramePadding.x;
+	const float copyButtonWidth = ImGui::CalcTextSize("Copy").x + 2.f * style.FramePadding.x;
+	const float inputWidth = (width - goButtonWidth - copyButtonWidth - 3.f * style.ItemSpacing.x) / 3.f;
+
+	ImGui::SetNextItemWidth(inputWidth);
+	ImGui::InputInt("##JumpToIndex", &m_JumpToIndex, 0);
+	ImGui::SetItemTooltip("Index to jump to");
+	m_JumpToIndex = std::clamp(m_JumpToIndex, 0, lastIndex);
+
+	ImGui::SameLine();
+	if (ImGui::Button("Go") && rowCount > 0)
+	{
+		m_HighlightedIndex = static_cast<size_t>(m_JumpToIndex);
+		m_IsJumpRequested = true;
+	}
+
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(2.f * inputWidth);
+	ImGui::InputInt2("##CopyRange", m_CopyRange);
+	ImGui::SetItemTooltip("First and last index of the rows to copy");
+	m_CopyRange[0] = std::clamp(m_CopyRange[0], 0, lastIndex);
+	m_CopyRange[1] = std::clamp(m_CopyRange[1], m_CopyRange[0], lastIndex);
+
+	ImGui::SameLine();
+	if (!ImGui::Button("Copy") || rowCount == 0)
+		return {};
+
+	// Formatted only on request, so the memory used stays proportional to the copied range
+	std::string text;
+	for (int index = m_CopyRange[0]; index <= m_CopyRange[1]; ++index)
+	{
+		text += formatRow(static_cast<size_t>(index));
+		text += '\n';
+	}
+
+	ImGui::SetClipboardText(text.c_str());
+	return static_cast<size_t>(m_CopyRange[1] - m_CopyRange[0] + 1);
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+// Virtualized list of mesh elements, only the rows in view are formatted every frame
+class ElementTable
+{
+public:
+	using RowFormatter = std::function<std::string(const size_t index)>;
+
+public:
+	ElementTable(const char* const id);
+
+	// Returns the number of copied rows when the copy button was clicked
+	std::optional<size_t> Display(const ImVec2& size, const size_t rowCount, const ElementTable::RowFormatter& formatRow);
+
+	void Reset();
+
+private:
+	void DisplayRows(const ImVec2& size, const size_t rowCount, const ElementTable::RowFormatter& formatRow);
+	std::optional<size_t> DisplayControls(const float width, const size_t rowCount, const ElementTable::RowFormatter& formatRow);
+
+private:
+	std::string m_Id;
+
+	int m_JumpToIndex;
+	bool m_IsJumpRequested;
+	std::optional<size_t> m_HighlightedIndex;
+
+	int m_CopyRange[2];
+};
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "pch.h"
+#include "Application/MemoryPanel.h"
+
+#include "Core/Mesh.h"
+#include "Utils/MemoryUtils.h"
+#include "Utils/ScratchArena.h"
+
+namespace
+{
+	constexpr ImGuiTableFlags TABLE_FLAGS = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit;
+
+	void AddRow(const char* const name, const std::string& value)
+	{
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(name);
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(value.c_str());
+	}
+}
+
+void MemoryPanel::Display(bool& isOpen, const Mesh* const mesh) const
+{
+	if (!ImGui::Begin("Memory", &isOpen))
+	{
+		ImGui::End();
+		return;
+	}
+
+	DisplayProcessMemory();
+
+	if (mesh)
+	{
+		ImGui::Spacing();
+		DisplayMeshMemory(*mesh);
+	}
+
+	ImGui::End();
+}
+
+void MemoryPanel::DisplayProcessMemory() const
+{
+	ImGui::SeparatorText("Process");
+
+	if (!ImGui::BeginTable("##Process", 2, TABLE_FLAGS))
+		return;
+
+	AddRow("Resident memory", utils::FormatBytes(utils::GetCurrentResidentMemory()));
+	AddRow("Peak resident memory", utils::FormatBytes(utils::GetPeakResidentMemory()));
+
+	if (utils::IsAllocationTrackingEnabled())
+	{
+		const auto counters = utils::GetAllocationCounters();
+		AddRow("Heap memory", utils::FormatBytes(counters.CurrentBytes));
+		AddRow("Peak heap memory", utils::FormatBytes(counters.PeakBytes));
+		AddRow("Allocations", std::to_string(counters.AllocationCount));
+		AddRow("Live allocations", std::to_string(counters.AllocationCount - counters.DeallocationCount));
+	}
+	else
+	{
+		AddRow("Heap memory", "Not tracked");
+	}
+
+	AddRow("Scratch arenas", utils::FormatBytes(utils::ScratchArena::GetRetainedBytes()));
+
+	ImGui::EndTable();
+}
+
+void MemoryPanel::DisplayMeshMemory(const Mesh& mesh) const
+{
+	ImGui::SeparatorText("Mesh");
+
+	if (ImGui::BeginTable("##Mesh", 2, TABLE_FLAGS))
+	{
+		const auto memoryUsage = mesh.GetMemoryUsage();
+		AddRow("Vertices", utils::FormatBytes(memoryUsage.Vertices));
+		if (memoryUsage.SharedVertices > 0)
+			AddRow("Shared with other meshes", utils::FormatBytes(memoryUsage.SharedVertices));
+
+		AddRow("Triangles", utils::FormatBytes(memoryUsage.Triangles));
+		AddRow("Smooth vertex normals", utils::FormatBytes(memoryUsage.SmoothVertexNormals));
+		AddRow("BVH", utils::FormatBytes(memoryUsage.BVH));
+		AddRow("Triangle records", utils::FormatBytes(memoryUsage.TriangleRecords));
+		AddRow("Fast winding number", utils::FormatBytes(memoryUsage.FastWindingNumber));
+		AddRow("Classification grid", utils::FormatBytes(memoryUsage.ClassificationGrid));
+		AddRow("Total", utils::FormatBytes(memoryUsage.GetTotal()));
+		ImGui::EndTable();
+	}
+
+	const auto& vertices = mesh.GetVertices();
+	if (vertices.IsQuantized())
+	{
+		ImGui::SeparatorText("Compact storage");
+
+		if (ImGui::BeginTable("##Compact", 2, TABLE_FLAGS))
+		{
+			AddRow("Vertices", PositionBuffer::GetEncodingName(vertices.GetEncoding()));
+			AddRow("Vertex error", std::format("{:.3g}", vertices.GetMaxError()));
+			if (mesh.IsReady(Mesh::Attribute::SmoothVertexNormals))
+				AddRow("Normal error", std::format("{:.3g} degrees", RadToDeg(mesh.GetSmoothVertexNormals().GetMaxAngularError())));
+			else
+				AddRow("Normal error", "Calculating...");
+			ImGui::EndTable();
+		}
+	}
+
+	if (!utils::IsAllocationTrackingEnabled())
+		return;
+
+	ImGui::SeparatorText("Creation peaks, above the memory in use before");
+
+	const auto& constructionMemory = mesh.GetConstructionMemory();
+	if (!constructionMemory.IsExclusive)
+	{
+		// The counters are process-wide, another load or subdivision ran at the same time
+		ImGui::TextDisabled("not measured, shared with a concurrent operation");
+		return;
+	}
+
+	if (ImGui::BeginTable("##Creation", 2, TABLE_FLAGS))
+	{
+		if (constructionMemory.LoadPeakBytes > 0)
+			AddRow("Load", utils::FormatBytes(constructionMemory.LoadPeakBytes));
+
+		if (constructionMemory.SubdivisionPeakBytes > 0)
+			AddRow("Subdivision", utils::FormatBytes(constructionMemory.SubdivisionPeakBytes));
+
+		AddRow("Allocations", std::to_string(constructionMemory.AllocationCount));
+		ImGui::EndTable();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+class Mesh;
+
+// Window with the memory held by the mesh, the peaks of its creation and the process-wide counters
+class MemoryPanel
+{
+public:
+	void Display(bool& isOpen, const Mesh* const mesh) const;
+
+private:
+	void DisplayProcessMemory() const;
+	void DisplayMeshMemory(const Mesh& mesh) const;
+};
\ No newline at end of file
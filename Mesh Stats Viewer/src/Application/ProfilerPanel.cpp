@@ -0,0 +1,159 @@
+#include "pch.h"
+#include "Application/ProfilerPanel.h"
+
+#include "Utils/FileDialogUtils.h"
+
+namespace
+{
+	constexpr double REFRESH_INTERVAL_SECONDS = 0.5;
+	constexpr size_t HISTORY_SIZE = 120;
+
+	constexpr const char* EXPORT_TRACE_FILE_DIALOG_NAME = "Export Chrome Trace";
+	constexpr const char* EXPORT_TRACE_FILE_DIALOG_DEFAULT_PATH = "trace.json";
+	const std::vector<std::string> EXPORT_TRACE_FILE_DIALOG_FILTERS = { "JSON (*.json)", "*.json" };
+
+	double ToMilliseconds(const int64_t microseconds)
+	{
+		return microseconds / 1000.0;
+	}
+}
+
+ProfilerPanel::ProfilerPanel()
+	: m_EventCount(0)
+{
+}
+
+std::optional<Notification> ProfilerPanel::Display(bool& isOpen)
+{
+	if (!ImGui::Begin("Profiler", &isOpen))
+	{
+		ImGui::End();
+		return {};
+	}
+
+	auto& profiler = utils::Profiler::Get();
+
+	bool isEnabled = profiler.IsEnabled();
+	if (ImGui::Checkbox("Enabled", &isEnabled))
+		profiler.SetEnabled(isEnabled);
+
+	ImGui::SameLine();
+	if (ImGui::Button("Clear"))
+	{
+		profiler.Clear();
+		RefreshStatistics();
+	}
+
+	ImGui::SameLine();
+	const bool isExportRequested = ImGui::Button("Export Chrome Trace...");
+
+	if (m_RefreshTimer.GetElapsedSeconds() >= REFRESH_INTERVAL_SECONDS)
+		RefreshStatistics();
+
+	ImGui::SameLine();
+	ImGui::TextDisabled("%zu events", m_EventCount);
+
+	DisplayStatisticsTable();
+
+	ImGui::End();
+
+	if (!isExportRequested) return {};
+	return ExportChromeTrace();
+}
+
+void ProfilerPanel::RefreshStatistics()
+{
+	m_RefreshTimer.Reset();
+
+	const auto events = utils::Profiler::Get().GetEvents();
+	m_EventCount = events.size();
+
+	// Names are compared by their contents, the same literal may have different addresses in different translation units
+	std::unordered_map<std::string_view, size_t> nameToStatisticsIndex;
+	m_Statistics.clear();
+
+	for (const auto& event : events)
+	{
+		const auto [it, isInserted] = nameToStatisticsIndex.try_emplace(event.Name, m_Statistics.size());
+		if (isInserted)
+			m_Statistics.push_back({ event.Name });
+
+		auto& statistics = m_Statistics[it->second];
+		const double milliseconds = ToMilliseconds(event.Duration);
+
+		++statistics.CallCount;
+		statistics.TotalMilliseconds += milliseconds;
+		statistics.MaxMilliseconds = std::max(statistics.MaxMilliseconds, milliseconds);
+		statistics.HistoryMilliseconds.push_back(static_cast<float>(milliseconds));
+	}
+
+	for (auto& statistics : m_Statistics)
+	{
+		auto& history = statistics.HistoryMilliseconds;
+		if (history.size() > HISTORY_SIZE)
+			history.erase(history.begin(), history.end() - HISTORY_SIZE);
+	}
+
+	std::sort(m_Statistics.begin(), m_Statistics.end(),
+		[](const StageStatistics& left, const StageStatistics& right) -> bool
+		{
+			return left.TotalMilliseconds > right.TotalMilliseconds;
+		}
+	);
+}
+
+void ProfilerPanel::DisplayStatisticsTable() const
+{
+	static constexpr ImGuiTableFlags TABLE_FLAGS = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingFixedFit;
+
+	if (!ImGui::BeginTable("##Stages", 6, TABLE_FLAGS))
+		return;
+
+	ImGui::TableSetupScrollFreeze(0, 1);
+	ImGui::TableSetupColumn("Stage");
+	ImGui::TableSetupColumn("Calls");
+	ImGui::TableSetupColumn("Last (ms)");
+	ImGui::TableSetupColumn("Average (ms)");
+	ImGui::TableSetupColumn("Max (ms)");
+	ImGui::TableSetupColumn("History", ImGuiTableColumnFlags_WidthStretch);
+	ImGui::TableHeadersRow();
+
+	for (const auto& statistics : m_Statistics)
+	{
+		ImGui::TableNextRow();
+
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(statistics.Name.c_str());
+
+		ImGui::TableNextColumn();
+		ImGui::Text("%u", statistics.CallCount);
+
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", statistics.HistoryMilliseconds.back());
+
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", statistics.TotalMilliseconds / statistics.CallCount);
+
+		ImGui::TableNextColumn();
+		ImGui::Text("%.3f", statistics.MaxMilliseconds);
+
+		ImGui::TableNextColumn();
+		ImGui::PushID(statistics.Name.c_str());
+		ImGui::SetNextItemWidth(-FLT_MIN);
+		ImGui::PlotLines("##History", statistics.HistoryMilliseconds.data(), static_cast<int>(statistics.HistoryMilliseconds.size()));
+		ImGui::PopID();
+	}
+
+	ImGui::EndTable();
+}
+
+std::optional<Notification> ProfilerPanel::ExportChromeTrace() const
+{
+	const auto filepath = utils::SaveAsFileDialog(EXPORT_TRACE_FILE_DIALOG_NAME, EXPORT_TRACE_FILE_DIALOG_DEFAULT_PATH, EXPORT_TRACE_FILE_DIALOG_FILTERS);
+	if (!filepath) return {};
+
+	if (utils::Profiler::Get().ExportChromeTrace(*filepath))
+		return Notification::Info(std::format("Exported Chrome trace to: \"{}\"", filepath->string()));
+
+	return Notification::Error(std::format("Could not export Chrome trace to: \"{}\"", filepath->string()));
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Application/Notification.h"
+#include "Utils/TimeUtils.h"
+
+// Window with the per-stage timings of the profiler, refreshed a few times per second
+class ProfilerPanel
+{
+public:
+	ProfilerPanel();
+
+	// Returns the notification about an export of the trace, if there was one
+	std::optional<Notification> Display(bool& isOpen);
+
+private:
+	struct StageStatistics
+	{
+		std::string Name;
+		uint32_t CallCount = 0;
+		double TotalMilliseconds = 0.0;
+		double MaxMilliseconds = 0.0;
+		std::vector<float> HistoryMilliseconds; // The most recent calls, oldest first
+	};
+
+	void RefreshStatistics();
+	void DisplayStatisticsTable() const;
+	std::optional<Notification> ExportChromeTrace() const;
+
+private:
+	std::vector<ProfilerPanel::StageStatistics> m_Statistics;
+	size_t m_EventCount;
+	utils::Timer m_RefreshTimer;
+};
\ No newline at end of file
@@ -10,11 +10,15 @@ namespace
 	constexpr int OPENGL_PROFILE = GLFW_OPENGL_CORE_PROFILE;
 	constexpr const char* GLSL_VERSION = "#version 460 core";
 
-	bool s_GlfwInitialized = false;
+	// ImGui needs a couple of frames to settle after input, like hover states and layout changes
+	constexpr uint32_t FRAMES_AFTER_EVENT = 3;
+
+	// Read by the background jobs waking the main thread, see Window::PostEmptyEvent
+	std::atomic<bool> s_GlfwInitialized = false;
 
 	bool InitGlfw()
 	{
-		if (s_GlfwInitialized)
+		if (s_GlfwInitialized.load(std::memory_order_acquire))
 			return true;
 
 		glfwSetErrorCallback(
@@ -24,17 +28,19 @@ namespace
 			}
 		);
 
-		s_GlfwInitialized = glfwInit() == GLFW_TRUE;
-		return s_GlfwInitialized;
+		const bool isInitialized = glfwInit() == GLFW_TRUE;
+		s_GlfwInitialized.store(isInitialized, std::memory_order_release);
+		return isInitialized;
 	}
 
 	void ShutdownGlfw()
 	{
-		if (!s_GlfwInitialized)
+		if (!s_GlfwInitialized.load(std::memory_order_acquire))
 			return;
 
+		// Cleared first, so that no background job posts an event to a terminated GLFW
+		s_GlfwInitialized.store(false, std::memory_order_release);
 		glfwTerminate();
-		s_GlfwInitialized = false;
 	}
 
 	void ScaleImGui(const float scaleFactor)
@@ -351,9 +357,30 @@ bool Window::IsRunning() const
 	return !glfwWindowShouldClose(m_GlfwWindow);
 }
 
-void Window::Update() const
+void Window::Update(const double idleTimeout)
+{
+	PROFILE_SCOPE("Window::Update");
+
+	if (m_Data.PendingFrameCount > 0)
+	{
+		--m_Data.PendingFrameCount;
+		glfwPollEvents();
+		return;
+	}
+
+	glfwWaitEventsTimeout(idleTimeout);
+	m_Data.PendingFrameCount = FRAMES_AFTER_EVENT;
+}
+
+void Window::RequestFrames()
+{
+	m_Data.PendingFrameCount = std::max(m_Data.PendingFrameCount, FRAMES_AFTER_EVENT);
+}
+
+/*static*/ void Window::PostEmptyEvent()
 {
-	glfwPollEvents();
+	if (s_GlfwInitialized.load(std::memory_order_acquire))
+		glfwPostEmptyEvent();
 }
 
 void Window::StartFrame() const
@@ -365,6 +392,8 @@ void Window::StartFrame() const
 
 void Window::Render() const
 {
+	PROFILE_SCOPE("Window::Render");
+
 	ImGui::Render();
 	glClear(GL_COLOR_BUFFER_BIT);
 	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
@@ -36,7 +36,14 @@ public:
 	Window& operator=(Window&& other) noexcept;
 
 	bool IsRunning() const;
-	void Update() const;
+
+	// Renders a few frames after every event, then sleeps until the next event or until the timeout runs out
+	void Update(const double idleTimeout);
+	void RequestFrames();
+
+	// Wakes up a sleeping Update, can be called from any thread
+	static void PostEmptyEvent();
+
 	void StartFrame() const;
 	void Render() const;
 
@@ -79,6 +86,7 @@ private:
 		float Scale = 1.f;
 		bool VSync = false;
 		ImVec4 BackgroundColor;
+		uint32_t PendingFrameCount = 0;
 	};
 
 	Window::Data m_Data;
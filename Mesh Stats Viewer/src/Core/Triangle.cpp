@@ -1,7 +0,0 @@
-#include "pch.h"
-#include "Core/Triangle.h"
-
-Triangle::Triangle(const uint32_t vertexIndex0, const uint32_t vertexIndex1, const uint32_t vertexIndex2)
-	: VertexIndexes{ vertexIndex0, vertexIndex1, vertexIndex2 }
-{
-}
\ No newline at end of file
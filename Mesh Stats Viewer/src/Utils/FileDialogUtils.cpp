@@ -1,25 +1,8 @@
 #include "pch.h"
-#include "Utils/FileUtils.h"
+#include "Utils/FileDialogUtils.h"
 
 namespace utils
 {
-	std::optional<std::string> ReadFile(const fs::path& filepath)
-	{
-		std::ifstream file(filepath.c_str());
-		if (!file.is_open()) return {};
-
-		return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
-	}
-
-	bool WriteFile(const fs::path& filepath, const std::string& data)
-	{
-		std::ofstream file(filepath.c_str());
-		if (!file.is_open()) return false;
-
-		file << data;
-		return true;
-	}
-
 	std::optional<fs::path> OpenFileDialog(
 		const std::string& title /* = "Open" */,
 		const fs::path& defaultPath /* = "" */,
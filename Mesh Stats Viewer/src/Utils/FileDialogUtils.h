@@ -2,9 +2,6 @@
 
 namespace utils
 {
-	std::optional<std::string> ReadFile(const fs::path& filepath);
-	bool WriteFile(const fs::path& filepath, const std::string& data);
-
 	std::optional<fs::path> OpenFileDialog(
 		const std::string& title = "Open",
 		const fs::path& defaultPath = "",
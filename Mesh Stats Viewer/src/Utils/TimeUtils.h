@@ -1,8 +0,0 @@
-#pragma once
-
-namespace utils
-{
-	std::string GetDate();
-	std::string GetTime();
-	std::string GetDateTime();
-}
\ No newline at end of file
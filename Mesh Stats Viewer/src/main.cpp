@@ -1,11 +1,11 @@
 #include "pch.h"
 
 #include "Application/Application.h"
+#include "Utils/AllocationHooks.h"
 
 int main(int argc, char** argv)
 {
-    Application::Start(argc, argv);
-    return EXIT_SUCCESS;
+    return Application::Start(argc, argv);
 }
 
 #if defined(_WIN64) && defined(RELEASE)
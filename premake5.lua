@@ -1,6 +1,6 @@
 workspace "Mesh Stats Viewer"
     architecture "x86_64"
-    startproject "Mesh Stats Viewer"
+    startproject (os.target() == "windows" and "Mesh Stats Viewer" or "Mesh Stats Benchmark")
 
     configurations
     {
@@ -23,10 +23,25 @@ ObjDir = "%{BuildDir}/obj/%{OutDir}"
 
 ExternalDir = "%{wks.location}/external"
 
+SourceDirs = {}
+SourceDirs["Core"] = "%{wks.location}/Mesh Stats Core/src"
+SourceDirs["Viewer"] = "%{wks.location}/Mesh Stats Viewer/src"
+
+VendorDirs = {}
+VendorDirs["Core"] = "%{wks.location}/Mesh Stats Core/vendor"
+VendorDirs["Viewer"] = "%{wks.location}/Mesh Stats Viewer/vendor"
+
 IncludeDirs = {}
 IncludeDirs["GLFW"] = "%{ExternalDir}/glfw/include"
 
 LibDirs = {}
 LibDirs["GLFW"] = "%{ExternalDir}/glfw/lib"
 
-include "Mesh Stats Viewer"
\ No newline at end of file
+include "Mesh Stats Core"
+include "Mesh Stats CLI"
+include "Mesh Stats Benchmark"
+
+-- The viewer depends on GLFW and OpenGL binaries that are only provided for Windows
+if os.target() == "windows" then
+    include "Mesh Stats Viewer"
+end
\ No newline at end of file